@@ -0,0 +1,44 @@
+#! /usr/bin/env python
+"""
+This script tests the compilation of the parser to bytecode.
+
+The input file inputs is used: the electrons are injected with a density
+given by a function with constant and common subexpressions, see inputs.
+The weight of each particle is compared with the density function
+evaluated at the position of the particle.
+"""
+import sys
+import yt
+import numpy as np
+yt.funcs.mylog.setLevel(0)
+
+# Open plotfile specified in command line
+fn = sys.argv[1]
+ds = yt.load( fn )
+ad = ds.all_data()
+
+x = ad['electrons', 'particle_position_x'].v
+y = ad['electrons', 'particle_position_y'].v
+z = ad['electrons', 'particle_position_z'].v
+w = ad['electrons', 'particle_weight'].v
+
+# Same constants and density function as in inputs
+n0 = 1.e24
+a = 0.2
+L = 40.e-6
+waist = 10.e-6
+k = 2*np.pi/L
+r2 = (x**2 + y**2)/waist**2
+density = n0*( 1 + a*2*np.cos(k*x)*np.sin(k*z)
+               + a*np.exp(-2*r2)*(2*x*y + z**2)/waist**2 )
+
+# Weight of the particles: 2x2x2 particles per cell
+dV = np.prod( (ds.domain_right_edge - ds.domain_left_edge).v
+              / ds.domain_dimensions )
+expected_w = density * dV / 8
+
+error = np.max( np.abs(w - expected_w) / expected_w )
+print( "max relative error on the weights: %s" %error )
+
+assert w.size == np.prod(ds.domain_dimensions) * 8
+assert error < 1.e-12
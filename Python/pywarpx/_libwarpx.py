@@ -124,6 +124,8 @@ def _array1d_from_pointer(pointer, dtype, size):
 libwarpx.amrex_init.argtypes = (ctypes.c_int, _LP_LP_c_char)
 libwarpx.warpx_getParticleStructs.restype = _LP_particle_p
 libwarpx.warpx_getParticleArrays.restype = _LP_LP_c_particlereal
+libwarpx.warpx_getParticleCompIndex.restype = ctypes.c_int
+libwarpx.warpx_getParticleCompIndex.argtypes = (ctypes.c_int, ctypes.c_char_p)
 libwarpx.warpx_getEfield.restype = _LP_LP_c_real
 libwarpx.warpx_getEfieldLoVects.restype = _LP_c_int
 libwarpx.warpx_getEfieldCP.restype = _LP_LP_c_real
@@ -504,6 +506,18 @@ def get_particle_cpu(species_number, level=0):
     return [struct['cpu'] for struct in structs]
 
 
+def get_particle_comp_index(species_number, comp_name):
+    '''
+
+    Return the index of the particle component comp_name, e.g. 'Ex'.
+    The fields on the particles (Ex, ..., Bz) are runtime components,
+    whose index is not known in advance.
+
+    '''
+
+    return libwarpx.warpx_getParticleCompIndex(species_number, comp_name.encode('utf-8'))
+
+
 def get_particle_weight(species_number, level=0):
     '''
 
@@ -556,7 +570,7 @@ def get_particle_Ex(species_number, level=0):
 
     '''
 
-    return get_particle_arrays(species_number, 4, level)
+    return get_particle_arrays(species_number, get_particle_comp_index(species_number, 'Ex'), level)
 
 
 def get_particle_Ey(species_number, level=0):
@@ -567,7 +581,7 @@ def get_particle_Ey(species_number, level=0):
 
     '''
 
-    return get_particle_arrays(species_number, 5, level)
+    return get_particle_arrays(species_number, get_particle_comp_index(species_number, 'Ey'), level)
 
 
 def get_particle_Ez(species_number, level=0):
@@ -578,7 +592,7 @@ def get_particle_Ez(species_number, level=0):
 
     '''
 
-    return get_particle_arrays(species_number, 6, level)
+    return get_particle_arrays(species_number, get_particle_comp_index(species_number, 'Ez'), level)
 
 
 def get_particle_Bx(species_number, level=0):
@@ -589,7 +603,7 @@ def get_particle_Bx(species_number, level=0):
 
     '''
 
-    return get_particle_arrays(species_number, 7, level)
+    return get_particle_arrays(species_number, get_particle_comp_index(species_number, 'Bx'), level)
 
 
 def get_particle_By(species_number, level=0):
@@ -600,7 +614,7 @@ def get_particle_By(species_number, level=0):
 
     '''
 
-    return get_particle_arrays(species_number, 8, level)
+    return get_particle_arrays(species_number, get_particle_comp_index(species_number, 'By'), level)
 
 
 def get_particle_Bz(species_number, level=0):
@@ -611,7 +625,7 @@ def get_particle_Bz(species_number, level=0):
 
     '''
 
-    return get_particle_arrays(species_number, 9, level)
+    return get_particle_arrays(species_number, get_particle_comp_index(species_number, 'Bz'), level)
 
 
 def get_particle_theta(species_number, level=0):
@@ -623,7 +637,7 @@ def get_particle_theta(species_number, level=0):
     '''
 
     if geometry_dim == 'rz':
-        return get_particle_arrays(species_number, 10, level)
+        return get_particle_arrays(species_number, get_particle_comp_index(species_number, 'theta'), level)
     elif geometry_dim == '3d':
         return [np.arctan2(struct['y'], struct['x']) for struct in structs]
     elif geometry_dim == '2d':
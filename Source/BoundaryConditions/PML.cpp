@@ -1,6 +1,7 @@
 #include <PML.H>
 #include <WarpX.H>
 #include <WarpXConst.H>
+#include <WarpXUtil.H>
 
 #include <AMReX_Print.H>
 #include <AMReX_VisMF.H>
@@ -399,7 +400,9 @@ PML::PML (const BoxArray& grid_ba, const DistributionMapping& grid_dm,
         m_ok = true;
     }
 
-    DistributionMapping dm{ba};
+    // The PML boxes are on the same MPI ranks as the adjacent grid boxes
+    const DistributionMapping dm = MakeDistributionMapping(ba, grid_ba, grid_dm, m_grid_index_fp);
+    m_costs_fp.assign(ba.size(), 0.);
 
     // Define the number of guard cells in each direction, for E, B, and F
     IntVect nge = IntVect(AMREX_D_DECL(2, 2, 2));
@@ -489,7 +492,8 @@ PML::PML (const BoxArray& grid_ba, const DistributionMapping& grid_dm,
             MakeBoxArray(*cgeom, grid_cba_reduced, ncell, do_pml_in_domain, do_pml_Lo, do_pml_Hi) :
             MakeBoxArray(*cgeom, grid_cba, ncell, do_pml_in_domain, do_pml_Lo, do_pml_Hi);
 
-        DistributionMapping cdm{cba};
+        const DistributionMapping cdm = MakeDistributionMapping(cba, grid_cba, grid_dm, m_grid_index_cp);
+        m_costs_cp.assign(cba.size(), 0.);
 
         pml_E_cp[0].reset(new MultiFab(amrex::convert(cba,WarpX::Ex_nodal_flag), cdm, 3, nge));
         pml_E_cp[1].reset(new MultiFab(amrex::convert(cba,WarpX::Ey_nodal_flag), cdm, 3, nge));
@@ -536,6 +540,104 @@ PML::PML (const BoxArray& grid_ba, const DistributionMapping& grid_dm,
     }
 }
 
+DistributionMapping
+PML::MakeDistributionMapping (const BoxArray& pml_ba, const BoxArray& grid_ba,
+                              const DistributionMapping& grid_dm, Vector<int>& grid_index)
+{
+    const int nboxes = pml_ba.size();
+    Vector<int> pmap(nboxes);
+    grid_index.resize(nboxes);
+    for (int i = 0; i < nboxes; ++i)
+    {
+        // The adjacent grid box is the one with the largest overlap
+        // with the PML box grown by one cell
+        const auto isects = grid_ba.intersections(amrex::grow(pml_ba[i], 1));
+        long max_npts = 0;
+        grid_index[i] = -1;
+        for (const auto& is : isects) {
+            if (is.second.numPts() > max_npts) {
+                max_npts = is.second.numPts();
+                grid_index[i] = is.first;
+            }
+        }
+        pmap[i] = (grid_index[i] >= 0) ? grid_dm[grid_index[i]]
+                                       : i % ParallelDescriptor::NProcs();
+    }
+    return DistributionMapping(pmap);
+}
+
+void
+PML::AddCost (PatchType patch_type, int i, Real wt)
+{
+    auto& pml_costs = (patch_type == PatchType::fine) ? m_costs_fp : m_costs_cp;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    pml_costs[i] += wt;
+}
+
+void
+PML::AddCellCosts (PatchType patch_type, Real cells_wt)
+{
+    auto& pml_costs = (patch_type == PatchType::fine) ? m_costs_fp : m_costs_cp;
+    const auto& pml_E = (patch_type == PatchType::fine) ? pml_E_fp : pml_E_cp;
+    const BoxArray& ba = amrex::enclosedCells(pml_E[0]->boxArray());
+    for (int i : pml_E[0]->IndexArray()) {
+        pml_costs[i] += cells_wt * ba[i].d_numPts();
+    }
+}
+
+Real
+PML::NumLocalCells (PatchType patch_type) const
+{
+    const auto& pml_E = (patch_type == PatchType::fine) ? pml_E_fp : pml_E_cp;
+    const BoxArray& ba = amrex::enclosedCells(pml_E[0]->boxArray());
+    Real ncells = 0.;
+    for (int i : pml_E[0]->IndexArray()) {
+        ncells += ba[i].d_numPts();
+    }
+    return ncells;
+}
+
+void
+PML::TransferCosts (PatchType patch_type, LayoutData<Real>& costs)
+{
+    auto& pml_costs = (patch_type == PatchType::fine) ? m_costs_fp : m_costs_cp;
+    const auto& grid_index = (patch_type == PatchType::fine) ? m_grid_index_fp : m_grid_index_cp;
+    const int myproc = ParallelDescriptor::MyProc();
+    for (int i = 0, N = pml_costs.size(); i < N; ++i)
+    {
+        // (Only the boxes of this MPI rank have a non-zero cost)
+        if (pml_costs[i] == 0.) continue;
+        const int j = grid_index[i];
+        if (j >= 0 and costs.DistributionMap()[j] == myproc) {
+            costs[j] += pml_costs[i];
+        }
+        pml_costs[i] = 0.;
+    }
+}
+
+void
+PML::CopyFieldsFrom (const PML& pml)
+{
+    // The PML boxes are the same, only their distribution differs
+    auto redistribute = [] (std::unique_ptr<MultiFab>& dst, const std::unique_ptr<MultiFab>& src) {
+        if (dst and src) {
+            dst->Redistribute(*src, 0, 0, src->nComp(), src->nGrowVect());
+        }
+    };
+    for (int idim = 0; idim < 3; ++idim) {
+        redistribute(pml_E_fp[idim], pml.pml_E_fp[idim]);
+        redistribute(pml_B_fp[idim], pml.pml_B_fp[idim]);
+        redistribute(pml_j_fp[idim], pml.pml_j_fp[idim]);
+        redistribute(pml_E_cp[idim], pml.pml_E_cp[idim]);
+        redistribute(pml_B_cp[idim], pml.pml_B_cp[idim]);
+        redistribute(pml_j_cp[idim], pml.pml_j_cp[idim]);
+    }
+    redistribute(pml_F_fp, pml.pml_F_fp);
+    redistribute(pml_F_cp, pml.pml_F_cp);
+}
+
 BoxArray
 PML::MakeBoxArray (const amrex::Geometry& geom, const amrex::BoxArray& grid_ba,
                    int ncell, int do_pml_in_domain,
@@ -929,6 +1031,44 @@ PML::FillBoundaryF (PatchType patch_type)
     }
 }
 
+Vector<MultiFab*>
+PML::GetFillBoundaryMFs (PatchType patch_type, bool fill_E, bool fill_B, bool fill_F)
+{
+    // Same selection as in FillBoundaryE, FillBoundaryB and FillBoundaryF
+    Vector<MultiFab*> mfs;
+    const auto& pml_E = (patch_type == PatchType::fine) ? pml_E_fp : pml_E_cp;
+    const auto& pml_B = (patch_type == PatchType::fine) ? pml_B_fp : pml_B_cp;
+    const auto& pml_F = (patch_type == PatchType::fine) ? pml_F_fp : pml_F_cp;
+    if (fill_E && pml_E[0] && pml_E[0]->nGrowVect().max() > 0) {
+        for (int i = 0; i < 3; ++i) mfs.push_back(pml_E[i].get());
+    }
+    if (fill_B && pml_B[0]) {
+        for (int i = 0; i < 3; ++i) mfs.push_back(pml_B[i].get());
+    }
+    if (fill_F && pml_F && pml_F->nGrowVect().max() > 0) {
+        mfs.push_back(pml_F.get());
+    }
+    return mfs;
+}
+
+void
+PML::FillBoundary_nowait (PatchType patch_type, bool fill_E, bool fill_B, bool fill_F)
+{
+    const auto& period = (patch_type == PatchType::fine) ?
+        m_geom->periodicity() : m_cgeom->periodicity();
+    for (MultiFab* mf : GetFillBoundaryMFs(patch_type, fill_E, fill_B, fill_F)) {
+        mf->FillBoundary_nowait(period);
+    }
+}
+
+void
+PML::FillBoundary_finish (PatchType patch_type, bool fill_E, bool fill_B, bool fill_F)
+{
+    for (MultiFab* mf : GetFillBoundaryMFs(patch_type, fill_E, fill_B, fill_F)) {
+        mf->FillBoundary_finish();
+    }
+}
+
 void
 PML::CheckPoint (const std::string& dir) const
 {
@@ -954,26 +1094,38 @@ PML::CheckPoint (const std::string& dir) const
 }
 
 void
-PML::Restart (const std::string& dir)
+PML::Restart (const std::string& dir, bool remap)
 {
+    // With remap, the PML of the checkpoint may have another box
+    // decomposition: read it on its own layout, and copy it
+    auto read = [remap] (MultiFab& mf, const std::string& name, const Geometry* geom) {
+        if (remap) {
+            MultiFab chk_mf;
+            VisMF::Read(chk_mf, name);
+            RemapMultiFab(mf, chk_mf, geom->periodicity());
+        } else {
+            VisMF::Read(mf, name);
+        }
+    };
+
     if (pml_E_fp[0])
     {
-        VisMF::Read(*pml_E_fp[0], dir+"_Ex_fp");
-        VisMF::Read(*pml_E_fp[1], dir+"_Ey_fp");
-        VisMF::Read(*pml_E_fp[2], dir+"_Ez_fp");
-        VisMF::Read(*pml_B_fp[0], dir+"_Bx_fp");
-        VisMF::Read(*pml_B_fp[1], dir+"_By_fp");
-        VisMF::Read(*pml_B_fp[2], dir+"_Bz_fp");
+        read(*pml_E_fp[0], dir+"_Ex_fp", m_geom);
+        read(*pml_E_fp[1], dir+"_Ey_fp", m_geom);
+        read(*pml_E_fp[2], dir+"_Ez_fp", m_geom);
+        read(*pml_B_fp[0], dir+"_Bx_fp", m_geom);
+        read(*pml_B_fp[1], dir+"_By_fp", m_geom);
+        read(*pml_B_fp[2], dir+"_Bz_fp", m_geom);
     }
 
     if (pml_E_cp[0])
     {
-        VisMF::Read(*pml_E_cp[0], dir+"_Ex_cp");
-        VisMF::Read(*pml_E_cp[1], dir+"_Ey_cp");
-        VisMF::Read(*pml_E_cp[2], dir+"_Ez_cp");
-        VisMF::Read(*pml_B_cp[0], dir+"_Bx_cp");
-        VisMF::Read(*pml_B_cp[1], dir+"_By_cp");
-        VisMF::Read(*pml_B_cp[2], dir+"_Bz_cp");
+        read(*pml_E_cp[0], dir+"_Ex_cp", m_cgeom);
+        read(*pml_E_cp[1], dir+"_Ey_cp", m_cgeom);
+        read(*pml_E_cp[2], dir+"_Ez_cp", m_cgeom);
+        read(*pml_B_cp[0], dir+"_Bx_cp", m_cgeom);
+        read(*pml_B_cp[1], dir+"_By_cp", m_cgeom);
+        read(*pml_B_cp[2], dir+"_Bz_cp", m_cgeom);
     }
 }
 
@@ -1001,32 +1153,22 @@ PushPMLPSATDSinglePatch (
     // (Exy, Ezx, etc.) and the component (0 or 1) of the
     // MultiFabs (e.g. pml_E) is dictated by the
     // function that damps the PML
-    solver.ForwardTransform(*pml_E[0], Idx::Exy, 0);
-    solver.ForwardTransform(*pml_E[0], Idx::Exz, 1);
-    solver.ForwardTransform(*pml_E[1], Idx::Eyz, 0);
-    solver.ForwardTransform(*pml_E[1], Idx::Eyx, 1);
-    solver.ForwardTransform(*pml_E[2], Idx::Ezx, 0);
-    solver.ForwardTransform(*pml_E[2], Idx::Ezy, 1);
-    solver.ForwardTransform(*pml_B[0], Idx::Bxy, 0);
-    solver.ForwardTransform(*pml_B[0], Idx::Bxz, 1);
-    solver.ForwardTransform(*pml_B[1], Idx::Byz, 0);
-    solver.ForwardTransform(*pml_B[1], Idx::Byx, 1);
-    solver.ForwardTransform(*pml_B[2], Idx::Bzx, 0);
-    solver.ForwardTransform(*pml_B[2], Idx::Bzy, 1);
+    // All the fields are transformed at once, in the order of the
+    // spectral PML index (Exy, Exz, Eyx, ...)
+    const Vector<int> i_comp = {0, 1, 1, 0, 0, 1,
+                                0, 1, 1, 0, 0, 1};
+    solver.ForwardTransform(
+        {pml_E[0].get(), pml_E[0].get(), pml_E[1].get(), pml_E[1].get(),
+         pml_E[2].get(), pml_E[2].get(), pml_B[0].get(), pml_B[0].get(),
+         pml_B[1].get(), pml_B[1].get(), pml_B[2].get(), pml_B[2].get()},
+        i_comp, Idx::Exy);
     // Advance fields in spectral space
     solver.pushSpectralFields();
     // Perform backward Fourier Transform
-    solver.BackwardTransform(*pml_E[0], Idx::Exy, 0);
-    solver.BackwardTransform(*pml_E[0], Idx::Exz, 1);
-    solver.BackwardTransform(*pml_E[1], Idx::Eyz, 0);
-    solver.BackwardTransform(*pml_E[1], Idx::Eyx, 1);
-    solver.BackwardTransform(*pml_E[2], Idx::Ezx, 0);
-    solver.BackwardTransform(*pml_E[2], Idx::Ezy, 1);
-    solver.BackwardTransform(*pml_B[0], Idx::Bxy, 0);
-    solver.BackwardTransform(*pml_B[0], Idx::Bxz, 1);
-    solver.BackwardTransform(*pml_B[1], Idx::Byz, 0);
-    solver.BackwardTransform(*pml_B[1], Idx::Byx, 1);
-    solver.BackwardTransform(*pml_B[2], Idx::Bzx, 0);
-    solver.BackwardTransform(*pml_B[2], Idx::Bzy, 1);
+    solver.BackwardTransform(
+        {pml_E[0].get(), pml_E[0].get(), pml_E[1].get(), pml_E[1].get(),
+         pml_E[2].get(), pml_E[2].get(), pml_B[0].get(), pml_B[0].get(),
+         pml_B[1].get(), pml_B[1].get(), pml_B[2].get(), pml_B[2].get()},
+        i_comp, Idx::Exy);
 }
 #endif
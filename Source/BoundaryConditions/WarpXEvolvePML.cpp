@@ -46,12 +46,15 @@ WarpX::DampPML (int lev, PatchType patch_type)
         const auto& pml_F = (patch_type == PatchType::fine) ? pml[lev]->GetF_fp() : pml[lev]->GetF_cp();
         const auto& sigba = (patch_type == PatchType::fine) ? pml[lev]->GetMultiSigmaBox_fp()
                                                               : pml[lev]->GetMultiSigmaBox_cp();
+        LayoutData<Real>* cost = costs[lev].get();
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
         for ( MFIter mfi(*pml_E[0], TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
+            Real wt = amrex::second();
+
             const Box& tex  = mfi.tilebox(Ex_nodal_flag);
             const Box& tey  = mfi.tilebox(Ey_nodal_flag);
             const Box& tez  = mfi.tilebox(Ez_nodal_flag);
@@ -134,7 +137,16 @@ WarpX::DampPML (int lev, PatchType patch_type)
                 });
 
             }
+
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                Gpu::synchronize();
+                pml[lev]->AddCost(patch_type, mfi.index(), amrex::second() - wt);
+            }
         }
+
+        // The cost of the PML boxes is counted in the adjacent grid boxes
+        if (cost) pml[lev]->TransferCosts(patch_type, *cost);
     }
 }
 
@@ -167,12 +179,15 @@ WarpX::DampJPML (int lev, PatchType patch_type)
         const auto& pml_j = (patch_type == PatchType::fine) ? pml[lev]->Getj_fp() : pml[lev]->Getj_cp();
         const auto& sigba = (patch_type == PatchType::fine) ? pml[lev]->GetMultiSigmaBox_fp()
                                                             : pml[lev]->GetMultiSigmaBox_cp();
+        LayoutData<Real>* cost = costs[lev].get();
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
         for ( MFIter mfi(*pml_j[0], TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
+            Real wt = amrex::second();
+
             auto const& pml_jxfab = pml_j[0]->array(mfi);
             auto const& pml_jyfab = pml_j[1]->array(mfi);
             auto const& pml_jzfab = pml_j[2]->array(mfi);
@@ -228,8 +243,16 @@ WarpX::DampJPML (int lev, PatchType patch_type)
                                 x_lo,y_lo, zs_lo);
                 }
             );
+
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                Gpu::synchronize();
+                pml[lev]->AddCost(patch_type, mfi.index(), amrex::second() - wt);
+            }
         }
 
+        // The cost of the PML boxes is counted in the adjacent grid boxes
+        if (cost) pml[lev]->TransferCosts(patch_type, *cost);
     }
 }
 
@@ -0,0 +1,229 @@
+#include <AsyncWriter.H>
+
+#include <AMReX_PlotFileUtil.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_FPC.H>
+#include <AMReX_Utility.H>
+#include <AMReX_GpuDevice.H>
+
+#include <fstream>
+#include <memory>
+#include <utility>
+
+using namespace amrex;
+
+AsyncWriter::AsyncWriter (long max_staged_bytes)
+    : m_max_staged_bytes(max_staged_bytes)
+{
+    m_thread = std::thread(&AsyncWriter::writerLoop, this);
+}
+
+AsyncWriter::~AsyncWriter ()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+VisMF::Header::Version
+AsyncWriter::AsyncVersion (VisMF::Header::Version version)
+{
+    // The boxes are always written without FAB header, so that their
+    // offset in the data files is known before they are written.
+    switch (version) {
+    case VisMF::Header::Version_v1:
+        // Keep the min/max of each box in the header
+        return VisMF::Header::NoFabHeaderMinMax_v1;
+    case VisMF::Header::NoFabHeaderMinMax_v1:
+    case VisMF::Header::NoFabHeaderFAMinMax_v1:
+        return version;
+    default:
+        return VisMF::Header::NoFabHeader_v1;
+    }
+}
+
+void
+AsyncWriter::writerLoop ()
+{
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]{ return m_stop or not m_jobs.empty(); });
+            // Pending jobs are run before stopping
+            if (m_jobs.empty()) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_busy = true;
+        }
+        // This releases the staged data of the job (plain host buffers)
+        job();
+        job = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busy = false;
+        }
+        m_cv.notify_all();
+    }
+}
+
+void
+AsyncWriter::enqueue (std::function<void()> job, long nbytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back([this, job, nbytes] () {
+            job();
+            std::lock_guard<std::mutex> job_lock(m_mutex);
+            m_staged_bytes -= nbytes;
+        });
+    }
+    m_cv.notify_all();
+}
+
+void
+AsyncWriter::WriteMultiFab (const MultiFab& mf, const std::string& mf_name)
+{
+    BL_PROFILE("AsyncWriter::WriteMultiFab()");
+
+    const VisMF::Header::Version version = AsyncVersion(VisMF::GetHeaderVersion());
+    const BoxArray& ba = mf.boxArray();
+    const DistributionMapping& dm = mf.DistributionMap();
+    const int ncomp = mf.nComp();
+    const IntVect ngrow = mf.nGrowVect();
+
+    // Size of the local data
+    long nbytes = 0;
+    for (int i : mf.IndexArray()) {
+        nbytes += amrex::grow(ba[i], ngrow).numPts() * ncomp * sizeof(Real);
+    }
+
+    // Wait for the writer until the staged data fits in memory
+    // (unless nothing is staged)
+    {
+        BL_PROFILE("AsyncWriter::WaitForMemory");
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this, nbytes]{
+            return m_staged_bytes == 0 or m_staged_bytes + nbytes <= m_max_staged_bytes; });
+        m_staged_bytes += nbytes;
+    }
+
+    // Copy the local data, including guard cells, to a host buffer owned
+    // by the job. (No MultiFab is created or destroyed on the writer
+    // thread, since this is not thread-safe in AMReX.)
+    auto staged = std::make_shared<Vector<char> >(nbytes);
+    {
+        char* p = staged->dataPtr();
+        for (int i : mf.IndexArray()) {
+            const FArrayBox& fab = mf[i];
+            Gpu::dtoh_memcpy(p, fab.dataPtr(), fab.nBytes());
+            p += fab.nBytes();
+        }
+    }
+
+    // Header: rank `p` writes its boxes, in order, in the file mf_name_D_p
+    const bool calc_min_max = (version != VisMF::Header::NoFabHeader_v1);
+    VisMF::Header hdr(mf, VisMF::NFiles, version, calc_min_max);
+    hdr.m_writtenRD = FPC::NativeRealDescriptor();
+    const std::string file_prefix = mf_name + VisMF::FabFileSuffix;
+    const std::string base_prefix = VisMF::BaseName(file_prefix);
+    Vector<long> offsets(ParallelDescriptor::NProcs(), 0);
+    hdr.m_fod.resize(ba.size());
+    for (int i = 0; i < ba.size(); ++i) {
+        const int owner = dm[i];
+        hdr.m_fod[i] = VisMF::FabOnDisk(amrex::Concatenate(base_prefix, owner, 5), offsets[owner]);
+        offsets[owner] += amrex::grow(ba[i], ngrow).numPts() * ncomp * sizeof(Real);
+    }
+    VisMF::WriteHeader(mf_name, hdr, ParallelDescriptor::IOProcessorNumber());
+
+    const std::string file_name = amrex::Concatenate(file_prefix, ParallelDescriptor::MyProc(), 5);
+    enqueue([staged, file_name] () {
+        // No MPI calls here: this runs on the writer thread
+        if (staged->empty()) return;
+        std::ofstream ofs(file_name, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!ofs.good()) amrex::FileOpenFailed(file_name);
+        // The local boxes are contiguous in the buffer, in order
+        ofs.write(staged->dataPtr(), staged->size());
+        ofs.close();
+        if (!ofs.good()) amrex::Abort("AsyncWriter: failed to write " + file_name);
+    }, nbytes);
+}
+
+void
+AsyncWriter::WritePlotfile (const std::string& plotfilename, int nlevels,
+                            const Vector<const MultiFab*>& mf,
+                            const Vector<std::string>& varnames,
+                            const Vector<Geometry>& geom,
+                            Real time, const Vector<int>& level_steps,
+                            const Vector<IntVect>& ref_ratio,
+                            const Vector<std::string>& extra_dirs)
+{
+    BL_PROFILE("AsyncWriter::WritePlotfile()");
+
+    const std::string level_prefix = "Level_";
+    const std::string mf_prefix = "Cell";
+
+    amrex::PreBuildDirectorHierarchy(plotfilename, level_prefix, nlevels, true);
+    for (const auto& d : extra_dirs) {
+        amrex::PreBuildDirectorHierarchy(plotfilename + "/" + d, level_prefix, nlevels, true);
+    }
+
+    if (ParallelDescriptor::IOProcessor()) {
+        const std::string header_name = plotfilename + "/Header";
+        std::ofstream HeaderFile(header_name);
+        if (!HeaderFile.good()) amrex::FileOpenFailed(header_name);
+        HeaderFile.precision(17);
+        Vector<BoxArray> boxArrays(nlevels);
+        for (int lev = 0; lev < nlevels; ++lev) {
+            boxArrays[lev] = mf[lev]->boxArray();
+        }
+        amrex::WriteGenericPlotfileHeader(HeaderFile, nlevels, boxArrays, varnames,
+                                          geom, time, level_steps, ref_ratio,
+                                          "HyperCLaw-V1.1", level_prefix, mf_prefix);
+    }
+
+    for (int lev = 0; lev < nlevels; ++lev) {
+        WriteMultiFab(*mf[lev], amrex::MultiFabFileFullPrefix(lev, plotfilename,
+                                                              level_prefix, mf_prefix));
+    }
+}
+
+void
+AsyncWriter::FinishOutput (const std::string& name)
+{
+    m_outputs.push_back(name);
+    enqueue([this] () {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_ncompleted;
+    }, 0);
+}
+
+void
+AsyncWriter::Poll ()
+{
+    // No output is outstanding. m_outputs is the same on all ranks, since
+    // FinishOutput is called at the same point on all ranks: they all
+    // return here, without communication.
+    if (m_nreported == static_cast<int>(m_outputs.size())) return;
+
+    int ncompleted;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ncompleted = m_ncompleted;
+    }
+    ParallelDescriptor::ReduceIntMin(ncompleted);
+    for ( ; m_nreported < ncompleted; ++m_nreported) {
+        amrex::Print() << "  Finished writing " << m_outputs[m_nreported] << "\n";
+    }
+}
+
+void
+AsyncWriter::Wait ()
+{
+    BL_PROFILE("AsyncWriter::Wait()");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]{ return m_jobs.empty() and not m_busy; });
+}
@@ -4,6 +4,10 @@
 #include "WarpX_f.H"
 #include "WarpX.H"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
 using namespace amrex;
 
 #ifdef WARPX_USE_HDF5
@@ -599,6 +603,81 @@ BoostedFrameDiagnostic(Real zmin_lab, Real zmax_lab, Real v_window_lab,
     }
 
     AMREX_ALWAYS_ASSERT(max_box_size_ >= num_buffer_);
+
+    pp.query("boosted_frame_diag_single_pass", single_pass_particles_);
+    pp.query("boosted_frame_diag_sparse_old_attribs", sparse_old_attribs_);
+    if (not WarpX::do_boosted_frame_particles) sparse_old_attribs_ = false;
+
+    pp.query("boosted_frame_diag_async_io", async_io_);
+    pp.query("boosted_frame_diag_max_pending_writes", max_pending_writes_);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(max_pending_writes_ >= 1,
+        "warpx.boosted_frame_diag_max_pending_writes must be at least 1");
+#ifdef WARPX_USE_HDF5
+    // The HDF5 particle output is collective
+    async_io_ = false;
+#endif
+    if (not WarpX::do_boosted_frame_particles) async_io_ = false;
+    if (async_io_) {
+        writer_thread_ = std::thread(&BoostedFrameDiagnostic::writerLoop, this);
+    }
+}
+
+BoostedFrameDiagnostic::~BoostedFrameDiagnostic()
+{
+    if (writer_thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(writer_mutex_);
+            writer_stop_ = true;
+        }
+        writer_cv_.notify_all();
+        writer_thread_.join();
+    }
+}
+
+void BoostedFrameDiagnostic::writerLoop()
+{
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(writer_mutex_);
+            writer_cv_.wait(lock, [this]{ return writer_stop_ or not writer_jobs_.empty(); });
+            // Pending jobs are run before stopping
+            if (writer_jobs_.empty()) return;
+            job = std::move(writer_jobs_.front());
+            writer_jobs_.pop_front();
+            writer_busy_ = true;
+        }
+        job();
+        // Release the buffers of the job before it stops counting as pending
+        job = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(writer_mutex_);
+            writer_busy_ = false;
+        }
+        writer_cv_.notify_all();
+    }
+}
+
+void BoostedFrameDiagnostic::enqueueWrite(std::function<void()> job)
+{
+    BL_PROFILE("BoostedFrameDiagnostic::enqueueWrite");
+    std::unique_lock<std::mutex> lock(writer_mutex_);
+    // Back-pressure: bound the memory held by the pending buffers,
+    // including those of the job being written
+    writer_cv_.wait(lock, [this]{
+        return static_cast<int>(writer_jobs_.size()) + (writer_busy_ ? 1 : 0)
+            < max_pending_writes_; });
+    writer_jobs_.push_back(std::move(job));
+    lock.unlock();
+    writer_cv_.notify_all();
+}
+
+void BoostedFrameDiagnostic::WaitForWrites()
+{
+    if (not async_io_) return;
+    BL_PROFILE("BoostedFrameDiagnostic::WaitForWrites");
+    std::unique_lock<std::mutex> lock(writer_mutex_);
+    writer_cv_.wait(lock, [this]{ return writer_jobs_.empty() and not writer_busy_; });
 }
 
 void BoostedFrameDiagnostic::Flush(const Geometry& geom)
@@ -671,9 +750,70 @@ void BoostedFrameDiagnostic::Flush(const Geometry& geom)
         }
     }
 
+    WaitForWrites();
+
     VisMF::SetHeaderVersion(current_version);
 }
 
+Vector<int>
+BoostedFrameDiagnostic::
+GetSliceIndices(const Geometry& geom, const Real t_boost) const {
+
+    const Real zlo_boost = geom.ProbLo(boost_direction_);
+    const Real zhi_boost = geom.ProbHi(boost_direction_);
+    const Real dx = geom.CellSize(boost_direction_);
+
+    Vector<int> slice_indices;
+    for (int i = 0; i < N_snapshots_; ++i) {
+        // Same positions and tests as in writeLabFrameData
+        const Real z_boost = (snapshots_[i].t_lab*inv_gamma_boost_ - t_boost)*PhysConst::c*inv_beta_boost_;
+        const Real z_lab = (snapshots_[i].t_lab - t_boost*inv_gamma_boost_)*PhysConst::c*inv_beta_boost_;
+        const Real zmin_lab = snapshots_[i].prob_domain_lab_.lo(AMREX_SPACEDIM-1);
+        const Real zmax_lab = snapshots_[i].prob_domain_lab_.hi(AMREX_SPACEDIM-1);
+        if ( (z_boost < zlo_boost) or (z_boost > zhi_boost) or
+             (z_lab < zmin_lab) or (z_lab > zmax_lab) ) continue;
+        slice_indices.push_back( static_cast<int>((z_boost - zlo_boost)/dx) );
+    }
+    return slice_indices;
+}
+
+Vector<std::pair<Real,Real> >
+BoostedFrameDiagnostic::
+GetParticleSlabs(const Geometry& geom, const Real t_boost, const Real dt) const {
+
+    const Real zlo_boost = geom.ProbLo(boost_direction_);
+    const Real zhi_boost = geom.ProbHi(boost_direction_);
+    // The particles move by less than c*dt during the step. Add one cell
+    // to account for roundoff errors.
+    const Real margin = geom.CellSize(boost_direction_);
+
+    Vector<std::pair<Real,Real> > slabs;
+    for (int i = 0; i < N_snapshots_; ++i) {
+        // Same positions and tests as in writeLabFrameData
+        const Real z_old = snapshots_[i].current_z_boost;
+        const Real z_boost = (snapshots_[i].t_lab*inv_gamma_boost_ - t_boost)*PhysConst::c*inv_beta_boost_;
+        const Real z_lab = (snapshots_[i].t_lab - t_boost*inv_gamma_boost_)*PhysConst::c*inv_beta_boost_;
+        const Real zmin_lab = snapshots_[i].prob_domain_lab_.lo(AMREX_SPACEDIM-1);
+        const Real zmax_lab = snapshots_[i].prob_domain_lab_.hi(AMREX_SPACEDIM-1);
+        if ( (z_boost < zlo_boost) or (z_boost > zhi_boost) or
+             (z_lab < zmin_lab) or (z_lab > zmax_lab) ) continue;
+        slabs.push_back( std::make_pair(std::min(z_boost, z_old) - PhysConst::c*dt - margin,
+                                        std::max(z_boost, z_old) + PhysConst::c*dt + margin) );
+    }
+
+    // Sort and merge the overlapping intervals
+    std::sort(slabs.begin(), slabs.end());
+    Vector<std::pair<Real,Real> > merged;
+    for (const auto& slab : slabs) {
+        if (!merged.empty() && slab.first <= merged.back().second) {
+            merged.back().second = std::max(merged.back().second, slab.second);
+        } else {
+            merged.push_back(slab);
+        }
+    }
+    return merged;
+}
+
 void
 BoostedFrameDiagnostic::
 writeLabFrameData(const MultiFab* cell_centered_data,
@@ -691,6 +831,14 @@ writeLabFrameData(const MultiFab* cell_centered_data,
 
     const std::vector<std::string> species_names = mypc.GetSpeciesNames();
 
+    // Snapshots that intersect the simulation domain at this step, and
+    // corresponding z index in data_buffer_
+    Vector<int> active_snapshots;
+    Vector<int> active_i_lab;
+    // Position of the active snapshots at the previous and current step,
+    // for the single-pass particle diagnostics
+    Vector<Real> active_z_old, active_z_new, active_t_lab;
+
     // Loop over snapshots
     for (int i = 0; i < N_snapshots_; ++i) {
 
@@ -760,12 +908,35 @@ writeLabFrameData(const MultiFab* cell_centered_data,
             CopySlice(tmp, *data_buffer_[i], i_lab, map_actual_fields_to_dump);
         }
 
-        if (WarpX::do_boosted_frame_particles) {
+        if (WarpX::do_boosted_frame_particles and single_pass_particles_) {
+            // Particles are added below, for all snapshots at once
+            active_z_old.push_back(old_z_boost);
+            active_z_new.push_back(snapshots_[i].current_z_boost);
+            active_t_lab.push_back(snapshots_[i].t_lab);
+        } else if (WarpX::do_boosted_frame_particles) {
             mypc.GetLabFrameData(snapshots_[i].file_name, i_lab, boost_direction_,
                                  old_z_boost, snapshots_[i].current_z_boost,
                                  t_boost, snapshots_[i].t_lab, dt, particles_buffer_[i]);
         }
 
+        active_snapshots.push_back(i);
+        active_i_lab.push_back(i_lab);
+    }
+
+    if (WarpX::do_boosted_frame_particles and single_pass_particles_
+        and not active_snapshots.empty()) {
+        // Sweep over the particles once, for all active snapshots
+        Vector<Vector<WarpXParticleContainer::DiagnosticParticleData>*> active_buffers;
+        for (int i : active_snapshots) active_buffers.push_back(&particles_buffer_[i]);
+        mypc.GetLabFrameDataMulti(boost_direction_, active_z_old, active_z_new,
+                                  t_boost, active_t_lab, dt, active_buffers);
+    }
+
+    // Loop over active snapshots, and write the full buffers
+    for (int k = 0; k < static_cast<int>(active_snapshots.size()); ++k) {
+
+        const int i = active_snapshots[k];
+        const int i_lab = active_i_lab[k];
 
         ++buff_counter_[i];
 
@@ -784,7 +955,24 @@ writeLabFrameData(const MultiFab* cell_centered_data,
 #endif
             }
 
-            if (WarpX::do_boosted_frame_particles) {
+            if (WarpX::do_boosted_frame_particles and async_io_) {
+                // Hand the particle buffers over to the writer thread.
+                // (They are reset when the next slice is stored.)
+                std::vector<std::string> paths;
+                for (int j = 0; j < mypc.nSpeciesBoostedFrameDiags(); ++j) {
+                    paths.push_back(snapshots_[i].file_name + "/" +
+                                    species_names[mypc.mapSpeciesBoostedFrameDiags(j)] + "/");
+                }
+                auto pbuffers = std::make_shared<Vector<WarpXParticleContainer::DiagnosticParticleData> >(
+                    std::move(particles_buffer_[i]));
+                particles_buffer_[i].clear();
+                const int my_proc = ParallelDescriptor::MyProc();
+                enqueueWrite([pbuffers, paths, i_lab, my_proc] () {
+                    for (int j = 0; j < static_cast<int>(paths.size()); ++j) {
+                        writeParticleFiles((*pbuffers)[j], paths[j], i_lab, my_proc);
+                    }
+                });
+            } else if (WarpX::do_boosted_frame_particles) {
                 // Loop over species to be dumped to BFD
                 for (int j = 0; j < mypc.nSpeciesBoostedFrameDiags(); ++j) {
                     // Get species name
@@ -866,48 +1054,30 @@ writeParticleData(const WarpXParticleContainer::DiagnosticParticleData& pdata,
 {
     BL_PROFILE("BoostedFrameDiagnostic::writeParticleData");
 
-    std::string field_name;
-    std::ofstream ofs;
+    writeParticleFiles(pdata, name, i_lab, ParallelDescriptor::MyProc());
+}
 
-    const int MyProc = ParallelDescriptor::MyProc();
+void
+BoostedFrameDiagnostic::
+writeParticleFiles(const WarpXParticleContainer::DiagnosticParticleData& pdata,
+                   const std::string& name, const int i_lab, const int my_proc)
+{
     auto np = pdata.GetRealData(DiagIdx::w).size();
 
     if (np == 0) return;
 
-    field_name = name + Concatenate("w_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeData(pdata.GetRealData(DiagIdx::w).data(), np, ofs);
-    ofs.close();
-
-    field_name = name + Concatenate("x_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeData(pdata.GetRealData(DiagIdx::x).data(), np, ofs);
-    ofs.close();
-
-    field_name = name + Concatenate("y_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeData(pdata.GetRealData(DiagIdx::y).data(), np, ofs);
-    ofs.close();
-
-    field_name = name + Concatenate("z_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeData(pdata.GetRealData(DiagIdx::z).data(), np, ofs);
-    ofs.close();
-
-    field_name = name + Concatenate("ux_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeData(pdata.GetRealData(DiagIdx::ux).data(), np, ofs);
-    ofs.close();
-
-    field_name = name + Concatenate("uy_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeData(pdata.GetRealData(DiagIdx::uy).data(), np, ofs);
-    ofs.close();
-
-    field_name = name + Concatenate("uz_", i_lab, 5) + "_" + std::to_string(MyProc);
-    ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
-    writeData(pdata.GetRealData(DiagIdx::uz).data(), np, ofs);
-    ofs.close();
+    const std::vector<std::pair<std::string,int> > components = {
+        {"w_", DiagIdx::w}, {"x_", DiagIdx::x}, {"y_", DiagIdx::y}, {"z_", DiagIdx::z},
+        {"ux_", DiagIdx::ux}, {"uy_", DiagIdx::uy}, {"uz_", DiagIdx::uz} };
+
+    for (const auto& comp : components) {
+        const std::string field_name = name + Concatenate(comp.first, i_lab, 5)
+            + "_" + std::to_string(my_proc);
+        std::ofstream ofs;
+        ofs.open(field_name.c_str(), std::ios::out|std::ios::binary);
+        writeData(pdata.GetRealData(comp.second).data(), np, ofs);
+        ofs.close();
+    }
 }
 
 void
@@ -1,6 +1,7 @@
 
 #include <WarpX.H>
 #include <FieldIO.H>
+#include <WarpXUtil.H>
 #ifdef WARPX_USE_OPENPMD
 #include <openPMD/openPMD.hpp>
 #endif
@@ -560,7 +561,9 @@ WarpX::AverageAndPackFields ( Vector<std::string>& varnames,
 
         if (costs[0] != nullptr)
         {
-            AverageAndPackScalarField( mf_avg[lev], *costs[lev], dcomp, ngrow );
+            MultiFab costs_mf(costs[lev]->boxArray(), costs[lev]->DistributionMap(), 1, 0);
+            CostsToMultiFab(*costs[lev], costs_mf, 0);
+            AverageAndPackScalarField( mf_avg[lev], costs_mf, dcomp, ngrow );
             if(lev==0) varnames.push_back("costs");
             dcomp += 1;
         }
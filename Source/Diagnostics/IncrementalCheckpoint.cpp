@@ -0,0 +1,344 @@
+#include <IncrementalCheckpoint.H>
+
+#include <AMReX_VisMF.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Reduce.H>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace amrex;
+
+IncrementalCheckpoint::IncrementalCheckpoint (int full_int, Real threshold)
+    : m_full_int(full_int), m_threshold(threshold)
+{}
+
+std::string
+IncrementalCheckpoint::ParentDir (const std::string& dir)
+{
+    std::string d = dir;
+    while (d.size() > 1 && d.back() == '/') d.pop_back();
+    const auto pos = d.find_last_of('/');
+    return (pos == std::string::npos) ? std::string() : d.substr(0, pos+1);
+}
+
+std::string
+IncrementalCheckpoint::CheckpointName (const std::string& dir)
+{
+    std::string d = dir;
+    while (d.size() > 1 && d.back() == '/') d.pop_back();
+    const auto pos = d.find_last_of('/');
+    return (pos == std::string::npos) ? d : d.substr(pos+1);
+}
+
+void
+IncrementalCheckpoint::BeginCheckpoint (const std::string& dir)
+{
+    m_dir = dir;
+    m_full = m_base.empty() or static_cast<int>(m_deltas.size()) + 1 >= m_full_int;
+    m_boxes.clear();
+}
+
+namespace {
+    // Hash of the bits of a value and of its position in the box
+    // (finalizer of splitmix64)
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    unsigned long long CellHash (Real v, unsigned long long pos) noexcept
+    {
+        union { Real r; unsigned long long u; } bits;
+        bits.u = 0;
+        bits.r = v;
+        unsigned long long h = bits.u ^ (pos * 0x9E3779B97F4A7C15ULL);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        return h ^ (h >> 31);
+    }
+}
+
+Vector<long>
+IncrementalCheckpoint::Fingerprints (const MultiFab& mf)
+{
+    BL_PROFILE("IncrementalCheckpoint::Fingerprints()");
+
+    static_assert(sizeof(long) == sizeof(unsigned long long),
+                  "IncrementalCheckpoint: the fingerprints are reduced as long");
+
+    const int ncomp = mf.nComp();
+    Vector<long> fingerprints(mf.size(), 0);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        // Sum of the hashes of all the cells, including guard cells
+        const Box& bx = mfi.fabbox();
+        const auto lo = amrex::lbound(bx);
+        const auto len = amrex::length(bx);
+        const auto& arr = mf.array(mfi);
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<unsigned long long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_op.eval(bx, ncomp, reduce_data,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) -> ReduceTuple
+        {
+            const unsigned long long pos = (i-lo.x) + len.x*((j-lo.y) + len.y*(
+                (k-lo.z) + static_cast<unsigned long long>(len.z)*n));
+            return {CellHash(arr(i,j,k,n), pos)};
+        });
+        const unsigned long long h = amrex::get<0>(reduce_data.value());
+        std::memcpy(&fingerprints[mfi.index()], &h, sizeof(long));
+    }
+    // Each box is owned by one rank: the sum gathers the fingerprints
+    ParallelDescriptor::ReduceLongSum(fingerprints.dataPtr(), fingerprints.size());
+    return fingerprints;
+}
+
+Vector<int>
+IncrementalCheckpoint::ChangedBoxes (const MultiFab& mf, const MultiFab& ref, Real threshold)
+{
+    BL_PROFILE("IncrementalCheckpoint::ChangedBoxes()");
+
+    const int ncomp = mf.nComp();
+    Vector<int> changed(mf.size(), 0);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        // Maximum difference in the box, including guard cells
+        const Box& bx = mfi.fabbox();
+        const auto& cur = mf.array(mfi);
+        const auto& old = ref.array(mfi);
+        ReduceOps<ReduceOpMax> reduce_op;
+        ReduceData<Real> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_op.eval(bx, ncomp, reduce_data,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) -> ReduceTuple
+        {
+            const Real d = cur(i,j,k,n) - old(i,j,k,n);
+            return {amrex::max(d, -d)};
+        });
+        if (amrex::get<0>(reduce_data.value()) > threshold) changed[mfi.index()] = 1;
+    }
+    ParallelDescriptor::ReduceIntSum(changed.dataPtr(), changed.size());
+    return changed;
+}
+
+void
+IncrementalCheckpoint::WriteMultiFab (const MultiFab& mf, const std::string& name,
+                                      const WriteFunction& write)
+{
+    BL_PROFILE("IncrementalCheckpoint::WriteMultiFab()");
+
+    const std::string full_name = m_dir + "/" + name;
+    const BoxArray& ba = mf.boxArray();
+    const DistributionMapping& dm = mf.DistributionMap();
+    const int ncomp = mf.nComp();
+    const IntVect ngrow = mf.nGrowVect();
+
+    auto& ref = m_reference[name];
+
+    // With threshold = 0, the boxes that changed are found from their
+    // fingerprints. Otherwise, a copy of the field is kept.
+    Vector<long> fingerprints;
+    if (m_threshold == 0.) fingerprints = Fingerprints(mf);
+
+    // A full write is also needed when the boxes have been redistributed
+    // since the previous checkpoint (load balancing)
+    if (m_full or ref.ba != ba or ref.dm != dm or ref.ncomp != ncomp or ref.ngrow != ngrow)
+    {
+        // Write the whole field, and keep its fingerprints or a copy of it
+        write(mf, full_name);
+        m_boxes[name] = Vector<int>{-1};
+        ref.ba = ba;
+        ref.dm = dm;
+        ref.ncomp = ncomp;
+        ref.ngrow = ngrow;
+        ref.fingerprints = fingerprints;
+        if (m_threshold > 0.) {
+            ref.mf.reset(new MultiFab(ba, dm, ncomp, ngrow));
+            MultiFab::Copy(*ref.mf, mf, 0, 0, ncomp, ngrow);
+        }
+        return;
+    }
+
+    Vector<int> changed(ba.size(), 0);
+    if (m_threshold == 0.)
+    {
+        for (int i = 0; i < ba.size(); ++i) {
+            changed[i] = (fingerprints[i] != ref.fingerprints[i]);
+        }
+        ref.fingerprints = fingerprints;
+    }
+    else
+    {
+        Real max_ref = 0.;
+        for (int n = 0; n < ncomp; ++n) {
+            max_ref = std::max(max_ref, ref.mf->norm0(n));
+        }
+        changed = ChangedBoxes(mf, *ref.mf, m_threshold * max_ref);
+    }
+
+    Vector<int> indices;
+    for (int i = 0; i < ba.size(); ++i) {
+        if (changed[i]) indices.push_back(i);
+    }
+    m_boxes[name] = indices;
+    if (indices.empty()) return;
+
+    // Copy the boxes that changed to a MultiFab with the same owners,
+    // write it, and update the copy of the field
+    BoxList bl(ba.ixType());
+    Vector<int> pmap;
+    for (int i : indices) {
+        bl.push_back(ba[i]);
+        pmap.push_back(dm[i]);
+    }
+    MultiFab delta(BoxArray(bl), DistributionMapping(pmap), ncomp, ngrow);
+    for (MFIter mfi(delta); mfi.isValid(); ++mfi)
+    {
+        const int i = indices[mfi.index()];
+        const Box& bx = delta[mfi].box();
+        delta[mfi].copy(mf[i], bx, 0, bx, 0, ncomp);
+        if (ref.mf) (*ref.mf)[i].copy(mf[i], bx, 0, bx, 0, ncomp);
+    }
+    write(delta, full_name);
+}
+
+void
+IncrementalCheckpoint::EndCheckpoint ()
+{
+    if (m_full) {
+        m_base = CheckpointName(m_dir);
+        m_deltas.clear();
+        return;
+    }
+
+    m_deltas.push_back(CheckpointName(m_dir));
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        const std::string header_name = m_dir + "/DeltaHeader";
+        std::ofstream HeaderFile(header_name);
+        if (!HeaderFile.good()) amrex::FileOpenFailed(header_name);
+
+        HeaderFile << m_base << "\n";
+        HeaderFile << m_deltas.size() << "\n";
+        for (const auto& d : m_deltas) {
+            HeaderFile << d << "\n";
+        }
+        HeaderFile << m_boxes.size() << "\n";
+        for (const auto& b : m_boxes) {
+            HeaderFile << b.first << " " << b.second.size();
+            for (int i : b.second) {
+                HeaderFile << " " << i;
+            }
+            HeaderFile << "\n";
+        }
+    }
+}
+
+bool
+IncrementalCheckpoint::ReadDeltaHeader (const std::string& dir, DeltaHeader& header)
+{
+    const std::string File(dir + "/DeltaHeader");
+    if (!amrex::FileExists(File)) return false;
+
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(File, fileCharPtr);
+    std::string fileCharPtrString(fileCharPtr.dataPtr());
+    std::istringstream is(fileCharPtrString, std::istringstream::in);
+
+    is >> header.base;
+    int ndeltas;
+    is >> ndeltas;
+    header.deltas.resize(ndeltas);
+    for (auto& d : header.deltas) {
+        is >> d;
+    }
+    int nfields;
+    is >> nfields;
+    for (int ifield = 0; ifield < nfields; ++ifield) {
+        std::string name;
+        int nboxes;
+        is >> name >> nboxes;
+        Vector<int>& indices = header.boxes[name];
+        indices.resize(nboxes);
+        for (auto& i : indices) {
+            is >> i;
+        }
+    }
+    return true;
+}
+
+void
+IncrementalCheckpoint::ReadMultiFab (MultiFab& mf, const std::string& dir,
+                                     const std::string& name)
+{
+    BL_PROFILE("IncrementalCheckpoint::ReadMultiFab()");
+
+    DeltaHeader header;
+    if (not ReadDeltaHeader(dir, header)) {
+        // Full checkpoint
+        VisMF::Read(mf, dir + "/" + name);
+        return;
+    }
+
+    const std::string parent = ParentDir(dir);
+    const std::string base_name = parent + header.base + "/" + name;
+    // The field may not be in the base checkpoint (e.g. for a level created
+    // after it), but it is then written in full in a delta checkpoint
+    bool initialized = VisMF::Exist(base_name);
+    if (initialized) {
+        VisMF::Read(mf, base_name);
+    }
+
+    // Replay the delta checkpoints
+    for (const auto& d : header.deltas)
+    {
+        const std::string delta_dir = parent + d;
+        DeltaHeader delta_header;
+        if (not ReadDeltaHeader(delta_dir, delta_header)) {
+            amrex::Abort("IncrementalCheckpoint: missing DeltaHeader in " + delta_dir);
+        }
+        const auto it = delta_header.boxes.find(name);
+        if (it == delta_header.boxes.end()) continue;
+        const Vector<int>& indices = it->second;
+        if (indices.empty()) continue;
+        if (indices[0] == -1) {
+            VisMF::Read(mf, delta_dir + "/" + name);
+            initialized = true;
+            continue;
+        }
+        if (not initialized) {
+            amrex::Abort("IncrementalCheckpoint: " + name + " is not in the base checkpoint "
+                         + parent + header.base);
+        }
+
+        const BoxArray& ba = mf.boxArray();
+        const DistributionMapping& dm = mf.DistributionMap();
+        BoxList bl(ba.ixType());
+        Vector<int> pmap;
+        for (int i : indices) {
+            bl.push_back(ba[i]);
+            pmap.push_back(dm[i]);
+        }
+        MultiFab delta(BoxArray(bl), DistributionMapping(pmap), mf.nComp(), mf.nGrowVect());
+        VisMF::Read(delta, delta_dir + "/" + name);
+        for (MFIter mfi(delta); mfi.isValid(); ++mfi)
+        {
+            const int i = indices[mfi.index()];
+            const Box& bx = delta[mfi].box();
+            mf[i].copy(delta[mfi], bx, 0, bx, 0, mf.nComp());
+        }
+    }
+
+    if (not initialized) {
+        amrex::Abort("IncrementalCheckpoint: " + name + " is not in the checkpoint " + dir
+                     + " nor in its base checkpoint " + parent + header.base);
+    }
+}
@@ -91,18 +91,19 @@ MultiParticleContainer::WritePlotFile (const std::string& dir) const
             real_names.push_back("momentum_y");
             real_names.push_back("momentum_z");
 
-            real_names.push_back("Ex");
-            real_names.push_back("Ey");
-            real_names.push_back("Ez");
-
-            real_names.push_back("Bx");
-            real_names.push_back("By");
-            real_names.push_back("Bz");
-
 #ifdef WARPX_DIM_RZ
             real_names.push_back("theta");
 #endif
 
+            // Runtime components, e.g. the fields on the particles when
+            // they are stored (see StoreFieldsOnParticles)
+            real_names.resize(pc->NumRealComps());
+            for (const auto& comp : pc->getParticleComps()) {
+                if (comp.second >= PIdx::nattribs) {
+                    real_names[comp.second] = comp.first;
+                }
+            }
+
             if(pc->do_field_ionization){
                 int_names.push_back("ionization_level");
                 // int_flags specifies, for each integer attribs, whether it is
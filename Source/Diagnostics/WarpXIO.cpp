@@ -4,6 +4,7 @@
 
 #include <WarpX.H>
 #include <FieldIO.H>
+#include <WarpXUtil.H>
 
 #include "AMReX_buildInfo.H"
 
@@ -13,6 +14,9 @@
 
 #include "SliceDiagnostic.H"
 
+#include <algorithm>
+#include <utility>
+
 #ifdef AMREX_USE_ASCENT
 #include <ascent.hpp>
 #include <AMReX_Conduit_Blueprint.H>
@@ -122,52 +126,73 @@ WarpX::WriteCheckPointFile() const
 
     WriteJobInfo(checkpointname);
 
+    // With asynchronous output, the fields are staged and written on the
+    // writer thread. (The PML and particle data are written synchronously.)
+    auto write_full = [this] (const MultiFab& mf, const std::string& mf_name) {
+        if (async_writer) {
+            async_writer->WriteMultiFab(mf, mf_name);
+        } else {
+            VisMF::Write(mf, mf_name);
+        }
+    };
+    // With incremental checkpoints, only the boxes that changed since the
+    // previous checkpoint are written, in between full checkpoints
+    if (incremental_checkpoint) incremental_checkpoint->BeginCheckpoint(checkpointname);
+    auto write_mf = [&] (const MultiFab& mf, const std::string& mf_name) {
+        if (incremental_checkpoint) {
+            incremental_checkpoint->WriteMultiFab(
+                mf, mf_name.substr(checkpointname.size()+1), write_full);
+        } else {
+            write_full(mf, mf_name);
+        }
+    };
+
     for (int lev = 0; lev < nlevels; ++lev)
     {
-        VisMF::Write(*Efield_fp[lev][0],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ex_fp"));
-        VisMF::Write(*Efield_fp[lev][1],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ey_fp"));
-        VisMF::Write(*Efield_fp[lev][2],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ez_fp"));
-        VisMF::Write(*Bfield_fp[lev][0],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bx_fp"));
-        VisMF::Write(*Bfield_fp[lev][1],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "By_fp"));
-        VisMF::Write(*Bfield_fp[lev][2],
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bz_fp"));
+        write_mf(*Efield_fp[lev][0],
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ex_fp"));
+        write_mf(*Efield_fp[lev][1],
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ey_fp"));
+        write_mf(*Efield_fp[lev][2],
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ez_fp"));
+        write_mf(*Bfield_fp[lev][0],
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bx_fp"));
+        write_mf(*Bfield_fp[lev][1],
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "By_fp"));
+        write_mf(*Bfield_fp[lev][2],
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bz_fp"));
         if (is_synchronized) {
             // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-            VisMF::Write(*current_fp[lev][0],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jx_fp"));
-            VisMF::Write(*current_fp[lev][1],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jy_fp"));
-            VisMF::Write(*current_fp[lev][2],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jz_fp"));
+            write_mf(*current_fp[lev][0],
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jx_fp"));
+            write_mf(*current_fp[lev][1],
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jy_fp"));
+            write_mf(*current_fp[lev][2],
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jz_fp"));
         }
 
         if (lev > 0)
         {
-            VisMF::Write(*Efield_cp[lev][0],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ex_cp"));
-            VisMF::Write(*Efield_cp[lev][1],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ey_cp"));
-            VisMF::Write(*Efield_cp[lev][2],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ez_cp"));
-            VisMF::Write(*Bfield_cp[lev][0],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bx_cp"));
-            VisMF::Write(*Bfield_cp[lev][1],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "By_cp"));
-            VisMF::Write(*Bfield_cp[lev][2],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bz_cp"));
+            write_mf(*Efield_cp[lev][0],
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ex_cp"));
+            write_mf(*Efield_cp[lev][1],
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ey_cp"));
+            write_mf(*Efield_cp[lev][2],
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Ez_cp"));
+            write_mf(*Bfield_cp[lev][0],
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bx_cp"));
+            write_mf(*Bfield_cp[lev][1],
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "By_cp"));
+            write_mf(*Bfield_cp[lev][2],
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "Bz_cp"));
             if (is_synchronized) {
                 // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-                VisMF::Write(*current_cp[lev][0],
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jx_cp"));
-                VisMF::Write(*current_cp[lev][1],
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jy_cp"));
-                VisMF::Write(*current_cp[lev][2],
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jz_cp"));
+                write_mf(*current_cp[lev][0],
+                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jx_cp"));
+                write_mf(*current_cp[lev][1],
+                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jy_cp"));
+                write_mf(*current_cp[lev][2],
+                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "jz_cp"));
             }
         }
 
@@ -176,13 +201,19 @@ WarpX::WriteCheckPointFile() const
         }
 
         if (costs[lev]) {
-            VisMF::Write(*costs[lev],
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "costs"));
+            MultiFab costs_mf(costs[lev]->boxArray(), costs[lev]->DistributionMap(), 1, 0);
+            CostsToMultiFab(*costs[lev], costs_mf, 0);
+            write_full(costs_mf,
+                       amrex::MultiFabFileFullPrefix(lev, checkpointname, level_prefix, "costs"));
         }
     }
 
     mypc->Checkpoint(checkpointname);
 
+    if (incremental_checkpoint) incremental_checkpoint->EndCheckpoint();
+
+    if (async_writer) async_writer->FinishOutput(checkpointname);
+
     VisMF::SetHeaderVersion(current_version);
 }
 
@@ -193,6 +224,11 @@ WarpX::InitFromCheckpoint ()
 
     amrex::Print() << "  Restart from checkpoint " << restart_chkfile << "\n";
 
+    // Layout of the checkpoint (with warpx.restart_remap, the data is
+    // read on this layout and copied to a new layout)
+    Vector<BoxArray> chk_grids;
+    Vector<DistributionMapping> chk_dmap;
+
     // Header
     {
         std::string File(restart_chkfile + "/WarpXHeader");
@@ -286,10 +322,32 @@ WarpX::InitFromCheckpoint ()
 
         ResetProbDomain(RealBox(prob_lo,prob_hi));
 
+        if (restart_remap && restart_max_grid_size > 0) {
+            SetMaxGridSize(restart_max_grid_size);
+        }
+
+        chk_grids.resize(nlevs);
+        chk_dmap.resize(nlevs);
         for (int lev = 0; lev < nlevs; ++lev) {
             BoxArray ba;
             ba.readFrom(is);
             GotoNextLine(is);
+            chk_grids[lev] = ba;
+            chk_dmap[lev] = DistributionMapping{ ba, ParallelDescriptor::NProcs() };
+            if (restart_remap) {
+                // Same region, chopped with the current max_grid_size
+                // and blocking_factor (as for the base grids)
+                const IntVect bf = blockingFactor(lev);
+                ba = BoxArray(chk_grids[lev].simplified_list());
+                ba.coarsen(bf);
+                ba.maxSize(maxGridSize(lev) / bf);
+                ba.refine(bf);
+                if (refine_grid_layout) {
+                    ChopGrids(lev, ba, ParallelDescriptor::NProcs());
+                }
+                amrex::Print() << "  Level " << lev << ": remap " << chk_grids[lev].size()
+                               << " boxes of the checkpoint onto " << ba.size() << " boxes\n";
+            }
             DistributionMapping dm { ba, ParallelDescriptor::NProcs() };
             SetBoxArray(lev, ba);
             SetDistributionMap(lev, dm);
@@ -304,6 +362,22 @@ WarpX::InitFromCheckpoint ()
     // Initialize the field data
     for (int lev = 0; lev < nlevs; ++lev)
     {
+        // The fields of incremental checkpoints are read from the base
+        // checkpoint and the delta checkpoints (see IncrementalCheckpoint).
+        // With warpx.restart_remap, they are read on the layout of the
+        // checkpoint, and copied to the new layout.
+        auto read_mf = [this, lev, &chk_grids, &chk_dmap] (MultiFab& mf, const std::string& mf_name) {
+            const std::string name = mf_name.substr(restart_chkfile.size()+1);
+            if (restart_remap) {
+                MultiFab chk_mf(amrex::convert(chk_grids[lev], mf.ixType()), chk_dmap[lev],
+                                mf.nComp(), mf.nGrowVect());
+                IncrementalCheckpoint::ReadMultiFab(chk_mf, restart_chkfile, name);
+                RemapMultiFab(mf, chk_mf, Geom(lev).periodicity());
+            } else {
+                IncrementalCheckpoint::ReadMultiFab(mf, restart_chkfile, name);
+            }
+        };
+
         for (int i = 0; i < 3; ++i) {
             current_fp[lev][i]->setVal(0.0);
             Efield_fp[lev][i]->setVal(0.0);
@@ -321,63 +395,71 @@ WarpX::InitFromCheckpoint ()
             }
         }
 
-        VisMF::Read(*Efield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"));
-        VisMF::Read(*Efield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"));
-        VisMF::Read(*Efield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"));
+        read_mf(*Efield_fp[lev][0],
+                 amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"));
+        read_mf(*Efield_fp[lev][1],
+                 amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"));
+        read_mf(*Efield_fp[lev][2],
+                 amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"));
 
-        VisMF::Read(*Bfield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"));
-        VisMF::Read(*Bfield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"));
-        VisMF::Read(*Bfield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"));
+        read_mf(*Bfield_fp[lev][0],
+                 amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"));
+        read_mf(*Bfield_fp[lev][1],
+                 amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"));
+        read_mf(*Bfield_fp[lev][2],
+                 amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"));
 
         if (is_synchronized) {
-            VisMF::Read(*current_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"));
-            VisMF::Read(*current_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"));
-            VisMF::Read(*current_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"));
+            read_mf(*current_fp[lev][0],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"));
+            read_mf(*current_fp[lev][1],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"));
+            read_mf(*current_fp[lev][2],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"));
         }
 
         if (lev > 0)
         {
-            VisMF::Read(*Efield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"));
-            VisMF::Read(*Efield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"));
-            VisMF::Read(*Efield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"));
-
-            VisMF::Read(*Bfield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"));
-            VisMF::Read(*Bfield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"));
-            VisMF::Read(*Bfield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"));
+            read_mf(*Efield_cp[lev][0],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"));
+            read_mf(*Efield_cp[lev][1],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"));
+            read_mf(*Efield_cp[lev][2],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"));
+
+            read_mf(*Bfield_cp[lev][0],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"));
+            read_mf(*Bfield_cp[lev][1],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"));
+            read_mf(*Bfield_cp[lev][2],
+                     amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"));
 
             if (is_synchronized) {
-                VisMF::Read(*current_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"));
-                VisMF::Read(*current_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"));
-                VisMF::Read(*current_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"));
+                read_mf(*current_cp[lev][0],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"));
+                read_mf(*current_cp[lev][1],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"));
+                read_mf(*current_cp[lev][2],
+                         amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"));
             }
         }
 
         if (costs[lev]) {
             const auto& cost_mf_name =
                 amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "costs");
+            MultiFab costs_mf(costs[lev]->boxArray(), costs[lev]->DistributionMap(), 1, 0);
             if (VisMF::Exist(cost_mf_name)) {
-                VisMF::Read(*costs[lev], cost_mf_name);
+                if (restart_remap) {
+                    MultiFab chk_costs;
+                    VisMF::Read(chk_costs, cost_mf_name);
+                    RemapMultiFab(costs_mf, chk_costs, Geom(lev).periodicity());
+                } else {
+                    VisMF::Read(costs_mf, cost_mf_name);
+                }
             } else {
-                costs[lev]->setVal(0.0);
+                costs_mf.setVal(0.0);
             }
+            MultiFabToCosts(costs_mf, *costs[lev]);
         }
     }
 
@@ -385,13 +467,31 @@ WarpX::InitFromCheckpoint ()
     {
         InitPML();
         for (int lev = 0; lev < nlevs; ++lev) {
-            pml[lev]->Restart(amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "pml"));
+            pml[lev]->Restart(amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "pml"),
+                              restart_remap);
         }
     }
 
     // Initilize particles
     mypc->AllocData();
+    if (restart_remap) {
+        // Read the particles on the layout of the checkpoint
+        for (int lev = 0; lev < nlevs; ++lev) {
+            mypc->SetParticleBoxArray(lev, chk_grids[lev]);
+            mypc->SetParticleDistributionMap(lev, chk_dmap[lev]);
+        }
+    }
     mypc->Restart(restart_chkfile);
+    if (restart_remap) {
+        // Empty layouts: the particles follow the grids of WarpX again
+        BoxArray empty_ba;
+        DistributionMapping empty_dm;
+        for (int lev = 0; lev < nlevs; ++lev) {
+            mypc->SetParticleBoxArray(lev, empty_ba);
+            mypc->SetParticleDistributionMap(lev, empty_dm);
+        }
+        mypc->Redistribute();
+    }
 
 #ifdef WARPX_DO_ELECTROSTATIC
     if (do_electrostatic) {
@@ -442,6 +542,94 @@ WarpX::GetCellCenteredData() {
     return std::move(cc[0]);
 }
 
+/* \brief Same as GetCellCenteredData, but only on the cells of level 0 that
+ *  are within one cell (along dir) of the cells with index slice_indices.
+ *  The returned MultiFab is defined on the parts of the level-0 boxes that
+ *  intersect these slabs, and has the same values there as the MultiFab
+ *  returned by GetCellCenteredData. Returns nullptr if no box intersects.
+ *
+ *  With mesh refinement, this falls back to GetCellCenteredData, since the
+ *  data of the finer levels needs to be averaged down.
+ */
+std::unique_ptr<MultiFab>
+WarpX::GetCellCenteredData (const Vector<int>& slice_indices, int dir) {
+
+    if (finest_level > 0) return GetCellCenteredData();
+
+    BL_PROFILE("WarpX::GetCellCenteredData(slices)");
+
+    const int ng =  1;
+    const int nc = 10;
+    const int lev = 0;
+
+    // Ranges of cells along dir (merged) that are needed to interpolate
+    // the data at the slices
+    Vector<std::pair<int,int>> ranges;
+    {
+        Vector<int> sorted = slice_indices;
+        std::sort(sorted.begin(), sorted.end());
+        for (int k : sorted) {
+            if (!ranges.empty() && k-1 <= ranges.back().second+1) {
+                ranges.back().second = std::max(ranges.back().second, k+1);
+            } else {
+                ranges.emplace_back(k-1, k+1);
+            }
+        }
+    }
+
+    // Parts of the boxes of level 0 that intersect the slabs. Each part
+    // stays on the process that owns the box.
+    BoxList bl;
+    Vector<int> procs;
+    for (int ibox = 0; ibox < grids[lev].size(); ++ibox) {
+        const Box& bx = grids[lev][ibox];
+        for (const auto& r : ranges) {
+            Box slab = bx;
+            slab.setSmall(dir, std::max(bx.smallEnd(dir), r.first));
+            slab.setBig(dir, std::min(bx.bigEnd(dir), r.second));
+            if (slab.ok()) {
+                bl.push_back(slab);
+                procs.push_back(dmap[lev][ibox]);
+            }
+        }
+    }
+    if (bl.isEmpty()) return nullptr;
+    const BoxArray ba(bl);
+    const DistributionMapping dm(procs);
+
+    // Copy of mf on the slabs (with the same staggering and guard cells)
+    auto slab_copy = [&ba, &dm] (const MultiFab& mf) {
+        std::unique_ptr<MultiFab> slab_mf( new MultiFab(amrex::convert(ba, mf.ixType()),
+                                                        dm, mf.nComp(), mf.nGrowVect()) );
+        slab_mf->ParallelCopy(mf, 0, 0, mf.nComp(), mf.nGrowVect(), mf.nGrowVect());
+        return slab_mf;
+    };
+    auto slab_copy_vector = [&slab_copy] (const std::array<std::unique_ptr<MultiFab>,3>& mf) {
+        std::array<std::unique_ptr<MultiFab>,3> slab_mf;
+        for (int i = 0; i < 3; ++i) slab_mf[i] = slab_copy(*mf[i]);
+        return slab_mf;
+    };
+
+    std::unique_ptr<MultiFab> cc( new MultiFab(ba, dm, nc, ng) );
+
+    int dcomp = 0;
+    // first the electric field
+    AverageAndPackVectorField( *cc, slab_copy_vector(Efield_aux[lev]), dm, dcomp, ng );
+    dcomp += 3;
+    // then the magnetic field
+    AverageAndPackVectorField( *cc, slab_copy_vector(Bfield_aux[lev]), dm, dcomp, ng );
+    dcomp += 3;
+    // then the current density
+    AverageAndPackVectorField( *cc, slab_copy_vector(current_fp[lev]), dm, dcomp, ng );
+    dcomp += 3;
+    // then the charge density
+    const std::unique_ptr<MultiFab>& charge_density = mypc->GetChargeDensity(lev);
+    AverageAndPackScalarField( *cc, *slab_copy(*charge_density), dcomp, ng );
+    cc->FillBoundary(geom[lev].periodicity());
+
+    return cc;
+}
+
 void
 WarpX::UpdateInSitu () const
 {
@@ -542,14 +730,21 @@ WarpX::WritePlotFile () const
     VisMF::Header::Version current_version = VisMF::GetHeaderVersion();
     VisMF::SetHeaderVersion(plotfile_headerversion);
     if (plot_raw_fields) rfs.emplace_back("raw_fields");
-    amrex::WriteMultiLevelPlotfile(plotfilename, finest_level+1,
-                                   output_mf, varnames, output_geom,
-                                   t_new[0], istep, refRatio(),
-                                   "HyperCLaw-V1.1",
-                                   "Level_",
-                                   "Cell",
-                                   rfs
-                                   );
+    if (async_writer) {
+        async_writer->WritePlotfile(plotfilename, finest_level+1,
+                                    output_mf, varnames, output_geom,
+                                    t_new[0], istep, refRatio(),
+                                    rfs);
+    } else {
+        amrex::WriteMultiLevelPlotfile(plotfilename, finest_level+1,
+                                       output_mf, varnames, output_geom,
+                                       t_new[0], istep, refRatio(),
+                                       "HyperCLaw-V1.1",
+                                       "Level_",
+                                       "Cell",
+                                       rfs
+                                       );
+    }
 
 
     if (plot_raw_fields)
@@ -622,6 +817,8 @@ WarpX::WritePlotFile () const
 
     WriteWarpXHeader(plotfilename);
 
+    if (async_writer) async_writer->FinishOutput(plotfilename);
+
     VisMF::SetHeaderVersion(current_version);
     } // endif: dump_plotfiles
 
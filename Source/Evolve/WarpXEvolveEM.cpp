@@ -52,31 +52,18 @@ WarpX::EvolveEM (int numsteps)
         if (costs[0] != nullptr)
         {
 #ifdef WARPX_USE_PSATD
-            amrex::Abort("LoadBalance for PSATD: TODO");
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!fft_hybrid_mpi_decomposition,
+                "Load balancing is not supported with psatd.hybrid_mpi_decomposition");
 #endif
 
-            if (step > 0 && (step+1) % load_balance_int == 0)
-            {
-                LoadBalance();
-                // Reset the costs to 0
-                for (int lev = 0; lev <= finest_level; ++lev) {
-                    costs[lev]->setVal(0.0);
-                }
-            }
-
-            for (int lev = 0; lev <= finest_level; ++lev) {
-                // Perform running average of the costs
-                // (Giving more importance to most recent costs)
-                (*costs[lev].get()).mult( (1. - 2./load_balance_int) );
-            }
+            CheckLoadBalance(step);
         }
 
         // At the beginning, we have B^{n} and E^{n}.
         // Particles have p^{n} and x^{n}.
         // is_synchronized is true.
         if (is_synchronized) {
-            FillBoundaryE();
-            FillBoundaryB();
+            FillBoundaryEB();
             UpdateAuxilaryData();
             // on first step, push p by -0.5*dt
             for (int lev = 0; lev <= finest_level; ++lev) {
@@ -89,12 +76,18 @@ WarpX::EvolveEM (int numsteps)
         } else {
             // Beyond one step, we have E^{n} and B^{n}.
             // Particles have p^{n-1/2} and x^{n}.
-            FillBoundaryE();
-            FillBoundaryB();
+            FillBoundaryEB();
             UpdateAuxilaryData();
 
         }
 
+        if (do_boosted_frame_diagnostic && myBFD->SparseOldAttribs()) {
+            // Particles only store their attributes before the push
+            // around the snapshot planes written at the end of this step
+            mypc->SetBoostedFrameDiagSlabs(
+                myBFD->GetParticleSlabs(geom[0], cur_time + dt[0], dt[0]));
+        }
+
         if (do_subcycling == 0 || finest_level == 0) {
             OneStep_nosub(cur_time);
         } else if (do_subcycling == 1 && finest_level == 1) {
@@ -144,7 +137,12 @@ WarpX::EvolveEM (int numsteps)
         if (do_boosted_frame_diagnostic) {
             std::unique_ptr<MultiFab> cell_centered_data = nullptr;
             if (WarpX::do_boosted_frame_fields) {
-                cell_centered_data = GetCellCenteredData();
+                // Only compute the cell-centered data around the slices
+                // that are written to the lab-frame snapshots
+                const Vector<int> slice_indices = myBFD->GetSliceIndices(geom[0], cur_time);
+                if (!slice_indices.empty()) {
+                    cell_centered_data = GetCellCenteredData(slice_indices, moving_window_dir);
+                }
             }
             myBFD->writeLabFrameData(cell_centered_data.get(), *mypc, geom[0], cur_time, dt[0]);
         }
@@ -165,8 +163,12 @@ WarpX::EvolveEM (int numsteps)
 
         bool to_sort = (sort_int > 0) && ((step+1) % sort_int == 0);
         if (to_sort) {
-            amrex::Print() << "re-sorting particles \n";
-            mypc->SortParticlesByCell();
+            if (sort_incremental) {
+                mypc->SortParticlesByCellIncremental();
+            } else {
+                amrex::Print() << "re-sorting particles \n";
+                mypc->SortParticlesByCell();
+            }
         }
 
         amrex::Print()<< "STEP " << step+1 << " ends." << " TIME = " << cur_time
@@ -185,8 +187,7 @@ WarpX::EvolveEM (int numsteps)
         // slice gen //
         if (to_make_plot || do_insitu || to_make_slice_plot)
         {
-            FillBoundaryE();
-            FillBoundaryB();
+            FillBoundaryEB();
             UpdateAuxilaryData();
 
             for (int lev = 0; lev <= finest_level; ++lev) {
@@ -218,6 +219,9 @@ WarpX::EvolveEM (int numsteps)
             WriteCheckPointFile();
         }
 
+        // Report the asynchronous outputs that are complete
+        if (async_writer) async_writer->Poll();
+
         if (cur_time >= stop_time - 1.e-3*dt[0]) {
             max_time_reached = true;
             break;
@@ -237,8 +241,7 @@ WarpX::EvolveEM (int numsteps)
 
     if (write_plot_file || do_insitu)
     {
-        FillBoundaryE();
-        FillBoundaryB();
+        FillBoundaryEB();
         UpdateAuxilaryData();
 
         for (int lev = 0; lev <= finest_level; ++lev) {
@@ -265,6 +268,11 @@ WarpX::EvolveEM (int numsteps)
         myBFD->Flush(geom[0]);
     }
 
+    if (async_writer) {
+        async_writer->Wait();
+        async_writer->Poll();
+    }
+
 #ifdef BL_USE_SENSEI_INSITU
     insitu_bridge->finalize();
 #endif
@@ -308,23 +316,42 @@ WarpX::OneStep_nosub (Real cur_time)
 #ifdef WARPX_USE_PSATD
     PushPSATD(dt[0]);
     if (do_pml) DampPML();
-    FillBoundaryE();
-    FillBoundaryB();
+    FillBoundaryEB();
 #else
     EvolveF(0.5*dt[0], DtType::FirstHalf);
     FillBoundaryF();
     EvolveB(0.5*dt[0]); // We now have B^{n+1/2}
-    FillBoundaryB();
 
-    EvolveE(dt[0]); // We now have E^{n+1}
-    FillBoundaryE();
-    EvolveF(0.5*dt[0], DtType::SecondHalf);
-    EvolveB(0.5*dt[0]); // We now have B^{n+1}
+    if (overlap_field_comm) {
+        // Overlap the exchange of the guard cells of B with the update of
+        // E in the cells whose stencil does not read guard cells of B
+        FillBoundaryB_nowait();
+        EvolveE(dt[0], FieldRegion::interior);
+        FillBoundaryB_finish();
+        EvolveE(dt[0], FieldRegion::boundary); // We now have E^{n+1}
+    } else {
+        FillBoundaryB();
+        EvolveE(dt[0]); // We now have E^{n+1}
+    }
+
+    if (overlap_field_comm && !do_dive_cleaning) {
+        // Same for B. (EvolveF reads the guard cells of E, so this is
+        // not done with divergence cleaning.)
+        FillBoundaryE_nowait();
+        EvolveB(0.5*dt[0], FieldRegion::interior);
+        FillBoundaryE_finish();
+        EvolveB(0.5*dt[0], FieldRegion::boundary); // We now have B^{n+1}
+    } else {
+        FillBoundaryE();
+        EvolveF(0.5*dt[0], DtType::SecondHalf);
+        EvolveB(0.5*dt[0]); // We now have B^{n+1}
+    }
     if (do_pml) {
         DampPML();
-        FillBoundaryE();
+        FillBoundaryEB();
+    } else {
+        FillBoundaryB();
     }
-    FillBoundaryB();
 
 #endif
 }
@@ -368,8 +395,7 @@ WarpX::OneStep_sub1 (Real curtime)
 
     EvolveB(fine_lev, PatchType::fine, 0.5*dt[fine_lev]);
     EvolveF(fine_lev, PatchType::fine, 0.5*dt[fine_lev], DtType::FirstHalf);
-    FillBoundaryB(fine_lev, PatchType::fine);
-    FillBoundaryF(fine_lev, PatchType::fine);
+    FillBoundaryFields(fine_lev, PatchType::fine, false, true, true); // B and F
 
     EvolveE(fine_lev, PatchType::fine, dt[fine_lev]);
     FillBoundaryE(fine_lev, PatchType::fine);
@@ -379,10 +405,10 @@ WarpX::OneStep_sub1 (Real curtime)
 
     if (do_pml) {
         DampPML(fine_lev, PatchType::fine);
-        FillBoundaryE(fine_lev, PatchType::fine);
     }
 
-    FillBoundaryB(fine_lev, PatchType::fine);
+    // E (if the PML was damped) and B
+    FillBoundaryFields(fine_lev, PatchType::fine, do_pml, true, false);
 
     // ii) Push particles on the coarse patch and mother grid.
     // Push the fields on the coarse patch and mother grid
@@ -394,16 +420,14 @@ WarpX::OneStep_sub1 (Real curtime)
 
     EvolveB(fine_lev, PatchType::coarse, dt[fine_lev]);
     EvolveF(fine_lev, PatchType::coarse, dt[fine_lev], DtType::FirstHalf);
-    FillBoundaryB(fine_lev, PatchType::coarse);
-    FillBoundaryF(fine_lev, PatchType::coarse);
+    FillBoundaryFields(fine_lev, PatchType::coarse, false, true, true); // B and F
 
     EvolveE(fine_lev, PatchType::coarse, dt[fine_lev]);
     FillBoundaryE(fine_lev, PatchType::coarse);
 
     EvolveB(coarse_lev, PatchType::fine, 0.5*dt[coarse_lev]);
     EvolveF(coarse_lev, PatchType::fine, 0.5*dt[coarse_lev], DtType::FirstHalf);
-    FillBoundaryB(coarse_lev, PatchType::fine);
-    FillBoundaryF(coarse_lev, PatchType::fine);
+    FillBoundaryFields(coarse_lev, PatchType::fine, false, true, true); // B and F
 
     EvolveE(coarse_lev, PatchType::fine, 0.5*dt[coarse_lev]);
     FillBoundaryE(coarse_lev, PatchType::fine);
@@ -422,8 +446,7 @@ WarpX::OneStep_sub1 (Real curtime)
 
     EvolveB(fine_lev, PatchType::fine, 0.5*dt[fine_lev]);
     EvolveF(fine_lev, PatchType::fine, 0.5*dt[fine_lev], DtType::FirstHalf);
-    FillBoundaryB(fine_lev, PatchType::fine);
-    FillBoundaryF(fine_lev, PatchType::fine);
+    FillBoundaryFields(fine_lev, PatchType::fine, false, true, true); // B and F
 
     EvolveE(fine_lev, PatchType::fine, dt[fine_lev]);
     FillBoundaryE(fine_lev, PatchType::fine);
@@ -433,11 +456,10 @@ WarpX::OneStep_sub1 (Real curtime)
 
     if (do_pml) {
         DampPML(fine_lev, PatchType::fine);
-        FillBoundaryE(fine_lev, PatchType::fine);
     }
 
-    FillBoundaryB(fine_lev, PatchType::fine);
-    FillBoundaryF(fine_lev, PatchType::fine);
+    // E (if the PML was damped), B and F
+    FillBoundaryFields(fine_lev, PatchType::fine, do_pml, true, true);
 
     // v) Push the fields on the coarse patch and mother grid
     // by only half a coarse step (second half)
@@ -454,11 +476,10 @@ WarpX::OneStep_sub1 (Real curtime)
     if (do_pml) {
         DampPML(fine_lev, PatchType::coarse); // do it twice
         DampPML(fine_lev, PatchType::coarse);
-        FillBoundaryE(fine_lev, PatchType::coarse);
     }
 
-    FillBoundaryB(fine_lev, PatchType::coarse);
-    FillBoundaryF(fine_lev, PatchType::coarse);
+    // E (if the PML was damped), B and F
+    FillBoundaryFields(fine_lev, PatchType::coarse, do_pml, true, true);
 
     EvolveE(coarse_lev, PatchType::fine, 0.5*dt[coarse_lev]);
     FillBoundaryE(coarse_lev, PatchType::fine);
@@ -468,10 +489,10 @@ WarpX::OneStep_sub1 (Real curtime)
 
     if (do_pml) {
         DampPML(coarse_lev, PatchType::fine);
-        FillBoundaryE(coarse_lev, PatchType::fine);
     }
 
-    FillBoundaryB(coarse_lev, PatchType::fine);
+    // E (if the PML was damped) and B
+    FillBoundaryFields(coarse_lev, PatchType::fine, do_pml, true, false);
 }
 
 void
@@ -0,0 +1,155 @@
+#include <FFTPlanCache.H>
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Print.H>
+
+#ifndef AMREX_USE_GPU
+
+using namespace amrex;
+
+bool FFTPlanCache::m_initialized = false;
+unsigned FFTPlanCache::m_flags = FFTW_ESTIMATE;
+std::string FFTPlanCache::m_wisdom_file;
+bool FFTPlanCache::m_new_plans = false;
+std::map<FFTPlanCache::PlanKey, fftw_plan> FFTPlanCache::m_plans;
+
+void
+FFTPlanCache::Initialize ()
+{
+    if (m_initialized) return;
+    m_initialized = true;
+
+    ParmParse pp("psatd");
+    std::string rigor = "estimate";
+    pp.query("fftw_plan_rigor", rigor);
+    if (rigor == "estimate") {
+        m_flags = FFTW_ESTIMATE;
+    } else if (rigor == "measure") {
+        m_flags = FFTW_MEASURE;
+    } else if (rigor == "patient") {
+        m_flags = FFTW_PATIENT;
+    } else if (rigor == "exhaustive") {
+        m_flags = FFTW_EXHAUSTIVE;
+    } else {
+        amrex::Abort("Unknown psatd.fftw_plan_rigor: " + rigor +
+                     " (should be estimate, measure, patient or exhaustive)");
+    }
+    pp.query("fftw_wisdom_file", m_wisdom_file);
+
+    if (!m_wisdom_file.empty()) {
+        // The file is read by the I/O processor, and broadcast
+        int exists = 0;
+        if (ParallelDescriptor::IOProcessor()) {
+            exists = amrex::FileExists(m_wisdom_file);
+        }
+        ParallelDescriptor::Bcast(&exists, 1, ParallelDescriptor::IOProcessorNumber());
+        if (exists) {
+            Vector<char> wisdom;
+            ParallelDescriptor::ReadAndBcastFile(m_wisdom_file, wisdom);
+            if (!fftw_import_wisdom_from_string(wisdom.dataPtr())) {
+                amrex::Print() << "Warning: could not import the FFTW wisdom from "
+                               << m_wisdom_file << "\n";
+            }
+        }
+    }
+}
+
+fftw_plan
+FFTPlanCache::getPlan (const IntVect& fft_size, bool forward, int howmany,
+                       void* in, void* out)
+{
+    const int in_alignment = fftw_alignment_of(static_cast<double*>(in));
+    const int out_alignment = fftw_alignment_of(static_cast<double*>(out));
+
+    PlanKey key;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        key[idim] = fft_size[idim];
+    }
+    key[AMREX_SPACEDIM] = forward;
+    key[AMREX_SPACEDIM+1] = howmany;
+    key[AMREX_SPACEDIM+2] = in_alignment;
+    key[AMREX_SPACEDIM+3] = out_alignment;
+
+    const auto it = m_plans.find(key);
+    if (it != m_plans.end()) return it->second;
+
+    // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
+    int n[AMREX_SPACEDIM];
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        n[idim] = fft_size[AMREX_SPACEDIM-1-idim];
+    }
+    // Number of points of one field, in real space and spectral space
+    // (for real-to-complex FFTs, the first dimension of the spectral
+    // space is fft_size[0]/2+1)
+    const int real_size = fft_size.product();
+    const int spectral_size = real_size / fft_size[0] * (fft_size[0]/2 + 1);
+    const std::size_t real_bytes = sizeof(double) * real_size * howmany;
+    const std::size_t spectral_bytes = sizeof(fftw_complex) * spectral_size * howmany;
+
+    // Plan on scratch arrays with the same alignment as the data
+    // (except for FFTW_ESTIMATE, which does not modify the arrays)
+    char* in_scratch = nullptr;
+    char* out_scratch = nullptr;
+    void* in_plan = in;
+    void* out_plan = out;
+    if (m_flags != FFTW_ESTIMATE) {
+        in_scratch = static_cast<char*>(fftw_malloc(
+            (forward ? real_bytes : spectral_bytes) + in_alignment));
+        out_scratch = static_cast<char*>(fftw_malloc(
+            (forward ? spectral_bytes : real_bytes) + out_alignment));
+        in_plan = in_scratch + in_alignment;
+        out_plan = out_scratch + out_alignment;
+    }
+
+    fftw_plan plan;
+    if (forward) {
+        plan = fftw_plan_many_dft_r2c( AMREX_SPACEDIM, n, howmany,
+            static_cast<double*>(in_plan), nullptr, 1, real_size,
+            static_cast<fftw_complex*>(out_plan), nullptr, 1, spectral_size,
+            m_flags );
+    } else {
+        plan = fftw_plan_many_dft_c2r( AMREX_SPACEDIM, n, howmany,
+            static_cast<fftw_complex*>(in_plan), nullptr, 1, spectral_size,
+            static_cast<double*>(out_plan), nullptr, 1, real_size,
+            m_flags );
+    }
+    if (in_scratch) fftw_free(in_scratch);
+    if (out_scratch) fftw_free(out_scratch);
+    if (plan == nullptr) {
+        amrex::Abort("FFTPlanCache: FFTW planning failed");
+    }
+    m_plans[key] = plan;
+    m_new_plans = true;
+    return plan;
+}
+
+fftw_plan
+FFTPlanCache::ForwardPlan (const IntVect& fft_size, int howmany,
+                           double* in, fftw_complex* out)
+{
+    return getPlan(fft_size, true, howmany, in, out);
+}
+
+fftw_plan
+FFTPlanCache::BackwardPlan (const IntVect& fft_size, int howmany,
+                            fftw_complex* in, double* out)
+{
+    return getPlan(fft_size, false, howmany, in, out);
+}
+
+void
+FFTPlanCache::ExportWisdom ()
+{
+    if (m_wisdom_file.empty() or !m_new_plans) return;
+    m_new_plans = false;
+    if (ParallelDescriptor::IOProcessor()) {
+        if (!fftw_export_wisdom_to_filename(m_wisdom_file.c_str())) {
+            amrex::Print() << "Warning: could not export the FFTW wisdom to "
+                           << m_wisdom_file << "\n";
+        }
+    }
+}
+
+#endif // AMREX_USE_GPU
@@ -1,4 +1,5 @@
 #include <SpectralFieldData.H>
+#include <FFTPlanCache.H>
 
 using namespace amrex;
 
@@ -14,10 +15,10 @@ SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
     // (one component per field)
     fields = SpectralField(spectralspace_ba, dm, n_field_required, 0);
 
-    // Allocate temporary arrays - in real space and spectral space
-    // These arrays will store the data just before/after the FFT
-    tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
-    tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    // Allocate temporary arrays in real space, for all the fields
+    // These arrays store the data just before/after the FFT
+    // (in spectral space, the FFT is done directly from/to `fields`)
+    tmpRealField = MultiFab(realspace_ba, dm, n_field_required, 0);
 
     // By default, we assume the FFT is done from/to a nodal grid in real space
     // It the FFT is performed from/to a cell-centered grid in real space,
@@ -42,6 +43,7 @@ SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
                                     ShiftType::TransformToCellCentered);
 #endif
 
+#ifdef AMREX_USE_GPU
     // Allocate and initialize the FFT plans
     forward_plan = FFTplans(spectralspace_ba, dm);
     backward_plan = FFTplans(spectralspace_ba, dm);
@@ -52,7 +54,6 @@ SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
         // differ when using real-to-complex FFT. When initializing
         // the FFT plan, the valid dimensions are those of the real-space box.
         IntVect fft_size = realspace_ba[mfi].length();
-#ifdef AMREX_USE_GPU
         // Create cuFFT plans
         // Creating 3D plan for real to complex -- double precision
         // Assuming CUDA is used for programming GPU
@@ -84,49 +85,27 @@ SpectralFieldData::SpectralFieldData( const BoxArray& realspace_ba,
            amrex::Print() << " cufftplan2d backward failed! \n";
         }
 #endif
-
-#else
-        // Create FFTW plans
-        forward_plan[mfi] =
-            // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
-#if (AMREX_SPACEDIM == 3)
-            fftw_plan_dft_r2c_3d( fft_size[2], fft_size[1], fft_size[0],
-#else
-            fftw_plan_dft_r2c_2d( fft_size[1], fft_size[0],
-#endif
-            tmpRealField[mfi].dataPtr(),
-            reinterpret_cast<fftw_complex*>( tmpSpectralField[mfi].dataPtr() ),
-            FFTW_ESTIMATE );
-        backward_plan[mfi] =
-            // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
-#if (AMREX_SPACEDIM == 3)
-            fftw_plan_dft_c2r_3d( fft_size[2], fft_size[1], fft_size[0],
+    }
 #else
-            fftw_plan_dft_c2r_2d( fft_size[1], fft_size[0],
-#endif
-            reinterpret_cast<fftw_complex*>( tmpSpectralField[mfi].dataPtr() ),
-            tmpRealField[mfi].dataPtr(),
-            FFTW_ESTIMATE );
+    // The FFTW plans are obtained from FFTPlanCache when the transforms
+    // are performed (they depend on the number of fields transformed at once)
+    FFTPlanCache::Initialize();
 #endif
-    }
 }
 
 
 SpectralFieldData::~SpectralFieldData()
 {
+#ifdef AMREX_USE_GPU
     if (tmpRealField.size() > 0){
         for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
-#ifdef AMREX_USE_GPU
             // Destroy cuFFT plans
             cufftDestroy( forward_plan[mfi] );
             cufftDestroy( backward_plan[mfi] );
-#else
-            // Destroy FFTW plans
-            fftw_destroy_plan( forward_plan[mfi] );
-            fftw_destroy_plan( backward_plan[mfi] );
-#endif
         }
     }
+#endif
+    // (The FFTW plans are owned by FFTPlanCache, and shared between boxes)
 }
 
 /* \brief Transform the component `i_comp` of MultiFab `mf`
@@ -137,36 +116,45 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
                                      const int field_index,
                                      const int i_comp )
 {
-    // Check field index type, in order to apply proper shift in spectral space
-    const bool is_nodal_x = mf.is_nodal(0);
-#if (AMREX_SPACEDIM == 3)
-    const bool is_nodal_y = mf.is_nodal(1);
-    const bool is_nodal_z = mf.is_nodal(2);
-#else
-    const bool is_nodal_z = mf.is_nodal(1);
-#endif
+    ForwardTransform( {&mf}, {i_comp}, field_index );
+}
+
+/* \brief Transform the components `i_comp[n]` of the MultiFabs `mf[n]`
+ *  to spectral space, and store the result in the spectral fields
+ *  `field_index+n`, with one (batched) FFT per box */
+void
+SpectralFieldData::ForwardTransform( const Vector<const MultiFab*>& mf,
+                                     const Vector<int>& i_comp,
+                                     const int field_index )
+{
+    const int nfields = mf.size();
+    AMREX_ALWAYS_ASSERT( static_cast<int>(i_comp.size()) == nfields );
+    AMREX_ALWAYS_ASSERT( nfields <= tmpRealField.nComp() );
+    AMREX_ALWAYS_ASSERT( field_index + nfields <= fields.nComp() );
 
     // Loop over boxes
-    for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
+    for ( MFIter mfi(*mf[0]); mfi.isValid(); ++mfi ){
 
-        // Copy the real-space field `mf` to the temporary field `tmpRealField`
+        // Copy the real-space fields `mf` to the temporary field `tmpRealField`
+        // (one component per field)
         // This ensures that all fields have the same number of points
         // before the Fourier transform.
         // As a consequence, the copy discards the *last* point of `mf`
         // in any direction that has *nodal* index type.
-        {
-            Box realspace_bx = mf[mfi].box(); // Copy the box
+        for (int n = 0; n < nfields; ++n) {
+            Box realspace_bx = (*mf[n])[mfi].box(); // Copy the box
             realspace_bx.enclosedCells(); // Discard last point in nodal direction
             AMREX_ALWAYS_ASSERT( realspace_bx == tmpRealField[mfi].box() );
-            Array4<const Real> mf_arr = mf[mfi].array();
+            Array4<const Real> mf_arr = (*mf[n])[mfi].array();
             Array4<Real> tmp_arr = tmpRealField[mfi].array();
+            const int mf_comp = i_comp[n];
             ParallelFor( realspace_bx,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                tmp_arr(i,j,k) = mf_arr(i,j,k,i_comp);
+                tmp_arr(i,j,k,n) = mf_arr(i,j,k,mf_comp);
             });
         }
 
-        // Perform Fourier transform from `tmpRealField` to `tmpSpectralField`
+        // Perform Fourier transform from `tmpRealField` to `fields`
 #ifdef AMREX_USE_GPU
         // Perform Fast Fourier Transform on GPU using cuFFT
         // make sure that this is done on the same
@@ -174,35 +162,57 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
         cufftResult result;
         cudaStream_t stream = amrex::Gpu::Device::cudaStream();
         cufftSetStream ( forward_plan[mfi], stream);
-        result = cufftExecD2Z( forward_plan[mfi],
-                               tmpRealField[mfi].dataPtr(),
-                               reinterpret_cast<cuDoubleComplex*>(
-                               tmpSpectralField[mfi].dataPtr()) );
-        if ( result != CUFFT_SUCCESS ) {
-           amrex::Print() << " forward transform using cufftExecD2Z failed ! \n";
+        for (int n = 0; n < nfields; ++n) {
+            result = cufftExecD2Z( forward_plan[mfi],
+                                   tmpRealField[mfi].dataPtr(n),
+                                   reinterpret_cast<cuDoubleComplex*>(
+                                   fields[mfi].dataPtr(field_index+n)) );
+            if ( result != CUFFT_SUCCESS ) {
+               amrex::Print() << " forward transform using cufftExecD2Z failed ! \n";
+            }
         }
 #else
-        fftw_execute( forward_plan[mfi] );
+        {
+            double* in = tmpRealField[mfi].dataPtr();
+            fftw_complex* out = reinterpret_cast<fftw_complex*>(
+                                    fields[mfi].dataPtr(field_index) );
+            const fftw_plan plan = FFTPlanCache::ForwardPlan(
+                tmpRealField[mfi].box().length(), nfields, in, out );
+            fftw_execute_dft_r2c( plan, in, out );
+        }
 #endif
 
-        // Copy the spectral-space field `tmpSpectralField` to the appropriate
-        // index of the FabArray `fields` (specified by `field_index`)
-        // and apply correcting shift factor if the real space data comes
+        // Apply correcting shift factor if the real space data comes
         // from a cell-centered grid in real space instead of a nodal grid.
-        {
+        for (int n = 0; n < nfields; ++n) {
+            // Check field index type, in order to apply proper shift in spectral space
+            const bool is_nodal_x = mf[n]->is_nodal(0);
+#if (AMREX_SPACEDIM == 3)
+            const bool is_nodal_y = mf[n]->is_nodal(1);
+            const bool is_nodal_z = mf[n]->is_nodal(2);
+#else
+            const bool is_nodal_z = mf[n]->is_nodal(1);
+#endif
+            // (No shift for a nodal field)
+#if (AMREX_SPACEDIM == 3)
+            if (is_nodal_x and is_nodal_y and is_nodal_z) continue;
+#else
+            if (is_nodal_x and is_nodal_z) continue;
+#endif
+
             Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
-            Array4<const Complex> tmp_arr = tmpSpectralField[mfi].array();
             const Complex* xshift_arr = xshift_FFTfromCell[mfi].dataPtr();
 #if (AMREX_SPACEDIM == 3)
             const Complex* yshift_arr = yshift_FFTfromCell[mfi].dataPtr();
 #endif
             const Complex* zshift_arr = zshift_FFTfromCell[mfi].dataPtr();
+            const int comp = field_index + n;
             // Loop over indices within one box
-            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+            const Box spectralspace_bx = fields[mfi].box();
 
             ParallelFor( spectralspace_bx,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                Complex spectral_field_value = tmp_arr(i,j,k);
+                Complex spectral_field_value = fields_arr(i,j,k,comp);
                 // Apply proper shift in each dimension
                 if (is_nodal_x==false) spectral_field_value *= xshift_arr[i];
 #if (AMREX_SPACEDIM == 3)
@@ -211,11 +221,14 @@ SpectralFieldData::ForwardTransform( const MultiFab& mf,
 #elif (AMREX_SPACEDIM == 2)
                 if (is_nodal_z==false) spectral_field_value *= zshift_arr[j];
 #endif
-                // Copy field into the right index
-                fields_arr(i,j,k,field_index) = spectral_field_value;
+                fields_arr(i,j,k,comp) = spectral_field_value;
             });
         }
     }
+
+#ifndef AMREX_USE_GPU
+    FFTPlanCache::ExportWisdom();
+#endif
 }
 
 
@@ -226,36 +239,57 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
                                       const int field_index,
                                       const int i_comp )
 {
-    // Check field index type, in order to apply proper shift in spectral space
-    const bool is_nodal_x = mf.is_nodal(0);
-#if (AMREX_SPACEDIM == 3)
-    const bool is_nodal_y = mf.is_nodal(1);
-    const bool is_nodal_z = mf.is_nodal(2);
-#else
-    const bool is_nodal_z = mf.is_nodal(1);
-#endif
+    BackwardTransform( {&mf}, {i_comp}, field_index );
+}
+
+/* \brief Transform the spectral fields `field_index+n` back to real space,
+ * and store them in the components `i_comp[n]` of the MultiFabs `mf[n]`,
+ * with one (batched) FFT per box. The complex-to-real FFT is done in place
+ * in `fields`: these spectral fields are overwritten. */
+void
+SpectralFieldData::BackwardTransform( const Vector<MultiFab*>& mf,
+                                      const Vector<int>& i_comp,
+                                      const int field_index )
+{
+    const int nfields = mf.size();
+    AMREX_ALWAYS_ASSERT( static_cast<int>(i_comp.size()) == nfields );
+    AMREX_ALWAYS_ASSERT( nfields <= tmpRealField.nComp() );
+    AMREX_ALWAYS_ASSERT( field_index + nfields <= fields.nComp() );
 
     // Loop over boxes
-    for ( MFIter mfi(mf); mfi.isValid(); ++mfi ){
+    for ( MFIter mfi(*mf[0]); mfi.isValid(); ++mfi ){
 
-        // Copy the spectral-space field `tmpSpectralField` to the appropriate
-        // field (specified by the input argument field_index)
-        // and apply correcting shift factor if the field is to be transformed
+        // Apply correcting shift factor if the field is to be transformed
         // to a cell-centered grid in real space instead of a nodal grid.
-        {
-            Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].array();
-            Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
+        for (int n = 0; n < nfields; ++n) {
+            // Check field index type, in order to apply proper shift in spectral space
+            const bool is_nodal_x = mf[n]->is_nodal(0);
+#if (AMREX_SPACEDIM == 3)
+            const bool is_nodal_y = mf[n]->is_nodal(1);
+            const bool is_nodal_z = mf[n]->is_nodal(2);
+#else
+            const bool is_nodal_z = mf[n]->is_nodal(1);
+#endif
+            // (No shift for a nodal field)
+#if (AMREX_SPACEDIM == 3)
+            if (is_nodal_x and is_nodal_y and is_nodal_z) continue;
+#else
+            if (is_nodal_x and is_nodal_z) continue;
+#endif
+
+            Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
             const Complex* xshift_arr = xshift_FFTtoCell[mfi].dataPtr();
 #if (AMREX_SPACEDIM == 3)
             const Complex* yshift_arr = yshift_FFTtoCell[mfi].dataPtr();
 #endif
             const Complex* zshift_arr = zshift_FFTtoCell[mfi].dataPtr();
+            const int comp = field_index + n;
             // Loop over indices within one box
-            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+            const Box spectralspace_bx = fields[mfi].box();
 
             ParallelFor( spectralspace_bx,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                Complex spectral_field_value = field_arr(i,j,k,field_index);
+                Complex spectral_field_value = fields_arr(i,j,k,comp);
                 // Apply proper shift in each dimension
                 if (is_nodal_x==false) spectral_field_value *= xshift_arr[i];
 #if (AMREX_SPACEDIM == 3)
@@ -264,12 +298,11 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
 #elif (AMREX_SPACEDIM == 2)
                 if (is_nodal_z==false) spectral_field_value *= zshift_arr[j];
 #endif
-                // Copy field into temporary array
-                tmp_arr(i,j,k) = spectral_field_value;
+                fields_arr(i,j,k,comp) = spectral_field_value;
             });
         }
 
-        // Perform Fourier transform from `tmpSpectralField` to `tmpRealField`
+        // Perform Fourier transform from `fields` to `tmpRealField`
 #ifdef AMREX_USE_GPU
         // Perform Fast Fourier Transform on GPU using cuFFT.
         // make sure that this is done on the same
@@ -277,23 +310,33 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
         cufftResult result;
         cudaStream_t stream = amrex::Gpu::Device::cudaStream();
         cufftSetStream ( backward_plan[mfi], stream);
-        result = cufftExecZ2D( backward_plan[mfi],
-                               reinterpret_cast<cuDoubleComplex*>(
-                               tmpSpectralField[mfi].dataPtr()),
-                               tmpRealField[mfi].dataPtr() );
-        if ( result != CUFFT_SUCCESS ) {
-           amrex::Print() << " Backward transform using cufftexecZ2D failed! \n";
+        for (int n = 0; n < nfields; ++n) {
+            result = cufftExecZ2D( backward_plan[mfi],
+                                   reinterpret_cast<cuDoubleComplex*>(
+                                   fields[mfi].dataPtr(field_index+n)),
+                                   tmpRealField[mfi].dataPtr(n) );
+            if ( result != CUFFT_SUCCESS ) {
+               amrex::Print() << " Backward transform using cufftexecZ2D failed! \n";
+            }
         }
 #else
-        fftw_execute( backward_plan[mfi] );
+        {
+            fftw_complex* in = reinterpret_cast<fftw_complex*>(
+                                   fields[mfi].dataPtr(field_index) );
+            double* out = tmpRealField[mfi].dataPtr();
+            const fftw_plan plan = FFTPlanCache::BackwardPlan(
+                tmpRealField[mfi].box().length(), nfields, in, out );
+            fftw_execute_dft_c2r( plan, in, out );
+        }
 #endif
 
-        // Copy the temporary field `tmpRealField` to the real-space field `mf`
+        // Copy the temporary field `tmpRealField` to the real-space fields `mf`
         // (only in the valid cells ; not in the guard cells)
         // Normalize (divide by 1/N) since the FFT+IFFT results in a factor N
-        {
-            Array4<Real> mf_arr = mf[mfi].array();
+        for (int n = 0; n < nfields; ++n) {
+            Array4<Real> mf_arr = (*mf[n])[mfi].array();
             Array4<const Real> tmp_arr = tmpRealField[mfi].array();
+            const int mf_comp = i_comp[n];
             // Normalization: divide by the number of points in realspace
             // (includes the guard cells)
             const Box realspace_bx = tmpRealField[mfi].box();
@@ -302,8 +345,12 @@ SpectralFieldData::BackwardTransform( MultiFab& mf,
             ParallelFor( mfi.validbox(),
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
                 // Copy and normalize field
-                mf_arr(i,j,k,i_comp) = inv_N*tmp_arr(i,j,k);
+                mf_arr(i,j,k,mf_comp) = inv_N*tmp_arr(i,j,k,n);
             });
         }
     }
+
+#ifndef AMREX_USE_GPU
+    FFTPlanCache::ExportWisdom();
+#endif
 }
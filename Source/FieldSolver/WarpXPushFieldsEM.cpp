@@ -1,6 +1,7 @@
 
 #include <cmath>
 #include <limits>
+#include <algorithm>
 
 #include <WarpX.H>
 #include <WarpXConst.H>
@@ -33,32 +34,29 @@ namespace {
         using Idx = SpectralFieldIndex;
 
         // Perform forward Fourier transform
-        solver.ForwardTransform(*Efield[0], Idx::Ex);
-        solver.ForwardTransform(*Efield[1], Idx::Ey);
-        solver.ForwardTransform(*Efield[2], Idx::Ez);
-        solver.ForwardTransform(*Bfield[0], Idx::Bx);
-        solver.ForwardTransform(*Bfield[1], Idx::By);
-        solver.ForwardTransform(*Bfield[2], Idx::Bz);
-        solver.ForwardTransform(*current[0], Idx::Jx);
-        solver.ForwardTransform(*current[1], Idx::Jy);
-        solver.ForwardTransform(*current[2], Idx::Jz);
-        solver.ForwardTransform(*rho, Idx::rho_old, 0);
-        solver.ForwardTransform(*rho, Idx::rho_new, 1);
+        // (all the fields at once: Ex, ..., Jz, rho_old and rho_new
+        // are consecutive spectral fields)
+        solver.ForwardTransform(
+            {Efield[0].get(), Efield[1].get(), Efield[2].get(),
+             Bfield[0].get(), Bfield[1].get(), Bfield[2].get(),
+             current[0].get(), current[1].get(), current[2].get(),
+             rho.get(), rho.get()},
+            {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}, Idx::Ex);
         // Advance fields in spectral space
         solver.pushSpectralFields();
         // Perform backward Fourier Transform
-        solver.BackwardTransform(*Efield[0], Idx::Ex);
-        solver.BackwardTransform(*Efield[1], Idx::Ey);
-        solver.BackwardTransform(*Efield[2], Idx::Ez);
-        solver.BackwardTransform(*Bfield[0], Idx::Bx);
-        solver.BackwardTransform(*Bfield[1], Idx::By);
-        solver.BackwardTransform(*Bfield[2], Idx::Bz);
+        solver.BackwardTransform(
+            {Efield[0].get(), Efield[1].get(), Efield[2].get(),
+             Bfield[0].get(), Bfield[1].get(), Bfield[2].get()},
+            {0, 0, 0, 0, 0, 0}, Idx::Ex);
     }
 }
 
 void
 WarpX::PushPSATD (amrex::Real a_dt)
 {
+    const Real wt_fields = amrex::second();
+
     for (int lev = 0; lev <= finest_level; ++lev) {
         AMREX_ALWAYS_ASSERT_WITH_MESSAGE(dt[lev] == a_dt, "dt must be consistent");
         if (fft_hybrid_mpi_decomposition){
@@ -74,6 +72,12 @@ WarpX::PushPSATD (amrex::Real a_dt)
             pml[lev]->PushPSATD();
         }
     }
+
+    // Wall time of the field solver, to calibrate the heuristic costs
+    if (costs_calibration_nsteps >= 0) {
+        Gpu::synchronize();
+        costs_calibration_fields_time += amrex::second() - wt_fields;
+    }
 }
 
 void
@@ -89,28 +93,67 @@ WarpX::PushPSATD_localFFT (int lev, amrex::Real /* dt */)
 }
 #endif
 
+namespace {
+    /* \brief Boxes of the cells of the tile box `tbx` that are updated by
+     *  the FDTD push, for the region `region`.
+     * \param tbx   : Tile box of the field (with the index type of the field).
+     * \param vbx   : Valid box of the field (with the index type of the field).
+     * \param region: FieldRegion::all returns tbx. FieldRegion::interior
+     *  returns the cells of tbx that are at least one cell away from the
+     *  boundaries of vbx: since the FDTD stencils extend by one cell, their
+     *  update does not read guard cells. FieldRegion::boundary returns the
+     *  other cells of tbx, as 2*AMREX_SPACEDIM disjoint (possibly empty) boxes.
+     */
+    Vector<Box>
+    getFieldRegionBoxes (const Box& tbx, const Box& vbx, FieldRegion region)
+    {
+        if (region == FieldRegion::all) return {tbx};
+
+        Vector<Box> boundary;
+        Box interior = tbx;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            // First and last interior index along idim
+            const int lo_cut = vbx.smallEnd(idim) + 1;
+            const int hi_cut = vbx.bigEnd(idim) - 1;
+            Box lo_slab = interior;
+            lo_slab.setBig(idim, std::min(interior.bigEnd(idim), lo_cut-1));
+            Box hi_slab = interior;
+            hi_slab.setSmall(idim, std::max({interior.smallEnd(idim), hi_cut+1, lo_cut}));
+            boundary.push_back(lo_slab);
+            boundary.push_back(hi_slab);
+            interior.setSmall(idim, std::max(interior.smallEnd(idim), lo_cut));
+            interior.setBig(idim, std::min(interior.bigEnd(idim), hi_cut));
+        }
+
+        if (region == FieldRegion::interior) return {interior};
+        return boundary;
+    }
+}
+
 void
-WarpX::EvolveB (Real a_dt)
+WarpX::EvolveB (Real a_dt, FieldRegion region)
 {
     for (int lev = 0; lev <= finest_level; ++lev) {
-        EvolveB(lev, a_dt);
+        EvolveB(lev, a_dt, region);
     }
 }
 
 void
-WarpX::EvolveB (int lev, Real a_dt)
+WarpX::EvolveB (int lev, Real a_dt, FieldRegion region)
 {
     BL_PROFILE("WarpX::EvolveB()");
-    EvolveB(lev, PatchType::fine, a_dt);
+    EvolveB(lev, PatchType::fine, a_dt, region);
     if (lev > 0)
     {
-        EvolveB(lev, PatchType::coarse, a_dt);
+        EvolveB(lev, PatchType::coarse, a_dt, region);
     }
 }
 
 void
-WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
+WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, FieldRegion region)
 {
+    const Real wt_fields = amrex::second();
+
     const int patch_level = (patch_type == PatchType::fine) ? lev : lev-1;
     const std::array<Real,3>& dx = WarpX::CellSize(patch_level);
     const Real dtsdx = a_dt/dx[0], dtsdy = a_dt/dx[1], dtsdz = a_dt/dx[2];
@@ -136,8 +179,7 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
         Bz = Bfield_cp[lev][2].get();
     }
 
-    MultiFab* cost = costs[lev].get();
-    const IntVect& rr = (lev > 0) ? refRatio(lev-1) : IntVect::TheUnitVector();
+    LayoutData<Real>* cost = costs[lev].get();
 
     // xmin is only used by the kernel for cylindrical geometry,
     // in which case it is actually rmin.
@@ -151,9 +193,13 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
     {
         Real wt = amrex::second();
 
-        const Box& tbx  = mfi.tilebox(Bx_nodal_flag);
-        const Box& tby  = mfi.tilebox(By_nodal_flag);
-        const Box& tbz  = mfi.tilebox(Bz_nodal_flag);
+        const Box& vbx = mfi.validbox();
+        const auto tbx_boxes = getFieldRegionBoxes(mfi.tilebox(Bx_nodal_flag),
+                                                  amrex::convert(vbx, Bx_nodal_flag), region);
+        const auto tby_boxes = getFieldRegionBoxes(mfi.tilebox(By_nodal_flag),
+                                                  amrex::convert(vbx, By_nodal_flag), region);
+        const auto tbz_boxes = getFieldRegionBoxes(mfi.tilebox(Bz_nodal_flag),
+                                                  amrex::convert(vbx, Bz_nodal_flag), region);
 
         auto const& Bxfab = Bx->array(mfi);
         auto const& Byfab = By->array(mfi);
@@ -161,81 +207,90 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
         auto const& Exfab = Ex->array(mfi);
         auto const& Eyfab = Ey->array(mfi);
         auto const& Ezfab = Ez->array(mfi);
-        if (do_nodal) {
-            amrex::ParallelFor(tbx, tby, tbz,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_bx_nodal(j,k,l,Bxfab,Eyfab,Ezfab,dtsdy,dtsdz);
-            },
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_by_nodal(j,k,l,Byfab,Exfab,Ezfab,dtsdx,dtsdz);
-            },
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_bz_nodal(j,k,l,Bzfab,Exfab,Eyfab,dtsdx,dtsdy);
-            });
-        } else if (WarpX::maxwell_fdtd_solver_id == 0) {
-            const long nmodes = n_rz_azimuthal_modes;
-            amrex::ParallelFor(tbx, tby, tbz,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_bx_yee(j,k,l,Bxfab,Eyfab,Ezfab,dtsdx,dtsdy,dtsdz,dxinv,xmin,nmodes);
-            },
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_by_yee(j,k,l,Byfab,Exfab,Ezfab,dtsdx,dtsdz,nmodes);
-            },
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_bz_yee(j,k,l,Bzfab,Exfab,Eyfab,dtsdx,dtsdy,dxinv,xmin,nmodes);
-            });
-        } else if (WarpX::maxwell_fdtd_solver_id == 1) {
-            Real betaxy, betaxz, betayx, betayz, betazx, betazy;
-            Real gammax, gammay, gammaz;
-            Real alphax, alphay, alphaz;
-            warpx_calculate_ckc_coefficients(dtsdx, dtsdy, dtsdz,
-                                             betaxy, betaxz, betayx, betayz, betazx, betazy,
-                                             gammax, gammay, gammaz,
-                                             alphax, alphay, alphaz);
-            amrex::ParallelFor(tbx, tby, tbz,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_bx_ckc(j,k,l,Bxfab,Eyfab,Ezfab,
-                                  betaxy, betaxz, betayx, betayz, betazx, betazy,
-                                  gammax, gammay, gammaz,
-                                  alphax, alphay, alphaz);
-            },
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_by_ckc(j,k,l,Byfab,Exfab,Ezfab,
-                                  betaxy, betaxz, betayx, betayz, betazx, betazy,
-                                  gammax, gammay, gammaz,
-                                  alphax, alphay, alphaz);
-            },
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_bz_ckc(j,k,l,Bzfab,Exfab,Eyfab,
-                                  betaxy, betaxz, betayx, betayz, betazx, betazy,
-                                  gammax, gammay, gammaz,
-                                  alphax, alphay, alphaz);
-            });
+
+        const int nboxes = tbx_boxes.size();
+        for (int ib = 0; ib < nboxes; ++ib)
+        {
+            const Box& tbx = tbx_boxes[ib];
+            const Box& tby = tby_boxes[ib];
+            const Box& tbz = tbz_boxes[ib];
+            if (!tbx.ok() && !tby.ok() && !tbz.ok()) continue;
+
+            if (do_nodal) {
+                amrex::ParallelFor(tbx, tby, tbz,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_bx_nodal(j,k,l,Bxfab,Eyfab,Ezfab,dtsdy,dtsdz);
+                },
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_by_nodal(j,k,l,Byfab,Exfab,Ezfab,dtsdx,dtsdz);
+                },
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_bz_nodal(j,k,l,Bzfab,Exfab,Eyfab,dtsdx,dtsdy);
+                });
+            } else if (WarpX::maxwell_fdtd_solver_id == 0) {
+                const long nmodes = n_rz_azimuthal_modes;
+                amrex::ParallelFor(tbx, tby, tbz,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_bx_yee(j,k,l,Bxfab,Eyfab,Ezfab,dtsdx,dtsdy,dtsdz,dxinv,xmin,nmodes);
+                },
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_by_yee(j,k,l,Byfab,Exfab,Ezfab,dtsdx,dtsdz,nmodes);
+                },
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_bz_yee(j,k,l,Bzfab,Exfab,Eyfab,dtsdx,dtsdy,dxinv,xmin,nmodes);
+                });
+            } else if (WarpX::maxwell_fdtd_solver_id == 1) {
+                Real betaxy, betaxz, betayx, betayz, betazx, betazy;
+                Real gammax, gammay, gammaz;
+                Real alphax, alphay, alphaz;
+                warpx_calculate_ckc_coefficients(dtsdx, dtsdy, dtsdz,
+                                                 betaxy, betaxz, betayx, betayz, betazx, betazy,
+                                                 gammax, gammay, gammaz,
+                                                 alphax, alphay, alphaz);
+                amrex::ParallelFor(tbx, tby, tbz,
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_bx_ckc(j,k,l,Bxfab,Eyfab,Ezfab,
+                                      betaxy, betaxz, betayx, betayz, betazx, betazy,
+                                      gammax, gammay, gammaz,
+                                      alphax, alphay, alphaz);
+                },
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_by_ckc(j,k,l,Byfab,Exfab,Ezfab,
+                                      betaxy, betaxz, betayx, betayz, betazx, betazy,
+                                      gammax, gammay, gammaz,
+                                      alphax, alphay, alphaz);
+                },
+                [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                {
+                    warpx_push_bz_ckc(j,k,l,Bzfab,Exfab,Eyfab,
+                                      betaxy, betaxz, betayx, betayz, betazx, betazy,
+                                      gammax, gammay, gammaz,
+                                      alphax, alphay, alphaz);
+                });
+            }
         }
 
-        if (cost) {
-            Box cbx = mfi.tilebox(IntVect{AMREX_D_DECL(0,0,0)});
-            if (patch_type == PatchType::coarse) cbx.refine(rr);
-            wt = (amrex::second() - wt) / cbx.d_numPts();
-            auto costfab = cost->array(mfi);
-            amrex::ParallelFor(cbx,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k)
-            {
-                costfab(i,j,k) += wt;
-            });
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            Gpu::synchronize();
+            wt = amrex::second() - wt;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            (*cost)[mfi.index()] += wt;
         }
     }
 
-    if (do_pml && pml[lev]->ok())
+    // The PML fields are pushed once, with the boundary region
+    if (do_pml && pml[lev]->ok() && region != FieldRegion::interior)
     {
         const auto& pml_B = (patch_type == PatchType::fine) ? pml[lev]->GetB_fp() : pml[lev]->GetB_cp();
         const auto& pml_E = (patch_type == PatchType::fine) ? pml[lev]->GetE_fp() : pml[lev]->GetE_cp();
@@ -245,6 +300,8 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
 #endif
         for ( MFIter mfi(*pml_B[0], TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
+            Real wt = amrex::second();
+
             const Box& tbx  = mfi.tilebox(Bx_nodal_flag);
             const Box& tby  = mfi.tilebox(By_nodal_flag);
             const Box& tbz  = mfi.tilebox(Bz_nodal_flag);
@@ -298,33 +355,50 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt)
                });
 
             }
+
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                Gpu::synchronize();
+                pml[lev]->AddCost(patch_type, mfi.index(), amrex::second() - wt);
+            }
         }
+
+        // The cost of the PML boxes is counted in the adjacent grid boxes
+        if (cost) pml[lev]->TransferCosts(patch_type, *cost);
+    }
+
+    // Wall time of the field solver, to calibrate the heuristic costs
+    if (costs_calibration_nsteps >= 0) {
+        Gpu::synchronize();
+        costs_calibration_fields_time += amrex::second() - wt_fields;
     }
 }
 
 void
-WarpX::EvolveE (Real a_dt)
+WarpX::EvolveE (Real a_dt, FieldRegion region)
 {
     for (int lev = 0; lev <= finest_level; ++lev)
     {
-        EvolveE(lev, a_dt);
+        EvolveE(lev, a_dt, region);
     }
 }
 
 void
-WarpX::EvolveE (int lev, Real a_dt)
+WarpX::EvolveE (int lev, Real a_dt, FieldRegion region)
 {
     BL_PROFILE("WarpX::EvolveE()");
-    EvolveE(lev, PatchType::fine, a_dt);
+    EvolveE(lev, PatchType::fine, a_dt, region);
     if (lev > 0)
     {
-        EvolveE(lev, PatchType::coarse, a_dt);
+        EvolveE(lev, PatchType::coarse, a_dt, region);
     }
 }
 
 void
-WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
+WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt, FieldRegion region)
 {
+    const Real wt_fields = amrex::second();
+
     const Real mu_c2_dt = (PhysConst::mu0*PhysConst::c*PhysConst::c) * a_dt;
     const Real c2dt = (PhysConst::c*PhysConst::c) * a_dt;
 
@@ -361,8 +435,7 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
         F  = F_cp[lev].get();
     }
 
-    MultiFab* cost = costs[lev].get();
-    const IntVect& rr = (lev > 0) ? refRatio(lev-1) : IntVect::TheUnitVector();
+    LayoutData<Real>* cost = costs[lev].get();
 
     // xmin is only used by the kernel for cylindrical geometry,
     // in which case it is actually rmin.
@@ -376,9 +449,13 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
     {
         Real wt = amrex::second();
 
-        const Box& tex  = mfi.tilebox(Ex_nodal_flag);
-        const Box& tey  = mfi.tilebox(Ey_nodal_flag);
-        const Box& tez  = mfi.tilebox(Ez_nodal_flag);
+        const Box& vbx = mfi.validbox();
+        const auto tex_boxes = getFieldRegionBoxes(mfi.tilebox(Ex_nodal_flag),
+                                                  amrex::convert(vbx, Ex_nodal_flag), region);
+        const auto tey_boxes = getFieldRegionBoxes(mfi.tilebox(Ey_nodal_flag),
+                                                  amrex::convert(vbx, Ey_nodal_flag), region);
+        const auto tez_boxes = getFieldRegionBoxes(mfi.tilebox(Ez_nodal_flag),
+                                                  amrex::convert(vbx, Ez_nodal_flag), region);
 
         auto const& Exfab = Ex->array(mfi);
         auto const& Eyfab = Ey->array(mfi);
@@ -390,102 +467,110 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
         auto const& jyfab = jy->array(mfi);
         auto const& jzfab = jz->array(mfi);
 
-        if (do_nodal) {
-            amrex::ParallelFor(tex, tey, tez,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_ex_nodal(j,k,l,Exfab,Byfab,Bzfab,jxfab,mu_c2_dt,dtsdy_c2,dtsdz_c2);
-            },
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_ey_nodal(j,k,l,Eyfab,Bxfab,Bzfab,jyfab,mu_c2_dt,dtsdx_c2,dtsdz_c2);
-            },
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_ez_nodal(j,k,l,Ezfab,Bxfab,Byfab,jzfab,mu_c2_dt,dtsdx_c2,dtsdy_c2);
-            });
-        } else {
-            const long nmodes = n_rz_azimuthal_modes;
-            amrex::ParallelFor(tex, tey, tez,
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_ex_yee(j,k,l,Exfab,Byfab,Bzfab,jxfab,mu_c2_dt,dtsdx_c2,dtsdy_c2,dtsdz_c2,dxinv,xmin,nmodes);
-            },
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_ey_yee(j,k,l,Eyfab,Bxfab,Bzfab,jyfab,Exfab,mu_c2_dt,dtsdx_c2,dtsdz_c2,xmin,nmodes);
-            },
-            [=] AMREX_GPU_DEVICE (int j, int k, int l)
-            {
-                warpx_push_ez_yee(j,k,l,Ezfab,Bxfab,Byfab,jzfab,mu_c2_dt,dtsdx_c2,dtsdy_c2,dxinv,xmin,nmodes);
-            });
-        }
-
-        if (F)
+        const int nboxes = tex_boxes.size();
+        for (int ib = 0; ib < nboxes; ++ib)
         {
-            auto const& Ffab = F->array(mfi);
-            if (WarpX::maxwell_fdtd_solver_id == 0) {
+            const Box& tex = tex_boxes[ib];
+            const Box& tey = tey_boxes[ib];
+            const Box& tez = tez_boxes[ib];
+            if (!tex.ok() && !tey.ok() && !tez.ok()) continue;
+
+            if (do_nodal) {
                 amrex::ParallelFor(tex, tey, tez,
                 [=] AMREX_GPU_DEVICE (int j, int k, int l)
                 {
-                    warpx_push_ex_f_yee(j,k,l,Exfab,Ffab,dtsdx_c2);
+                    warpx_push_ex_nodal(j,k,l,Exfab,Byfab,Bzfab,jxfab,mu_c2_dt,dtsdy_c2,dtsdz_c2);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l)
                 {
-                    warpx_push_ey_f_yee(j,k,l,Eyfab,Ffab,dtsdy_c2);
+                    warpx_push_ey_nodal(j,k,l,Eyfab,Bxfab,Bzfab,jyfab,mu_c2_dt,dtsdx_c2,dtsdz_c2);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l)
                 {
-                    warpx_push_ez_f_yee(j,k,l,Ezfab,Ffab,dtsdz_c2);
+                    warpx_push_ez_nodal(j,k,l,Ezfab,Bxfab,Byfab,jzfab,mu_c2_dt,dtsdx_c2,dtsdy_c2);
                 });
-            }
-            else if (WarpX::maxwell_fdtd_solver_id == 1) {
-                Real betaxy, betaxz, betayx, betayz, betazx, betazy;
-                Real gammax, gammay, gammaz;
-                Real alphax, alphay, alphaz;
-                warpx_calculate_ckc_coefficients(dtsdx_c2, dtsdy_c2, dtsdz_c2,
-                                                 betaxy, betaxz, betayx, betayz, betazx, betazy,
-                                                 gammax, gammay, gammaz,
-                                                 alphax, alphay, alphaz);
+            } else {
+                const long nmodes = n_rz_azimuthal_modes;
                 amrex::ParallelFor(tex, tey, tez,
                 [=] AMREX_GPU_DEVICE (int j, int k, int l)
                 {
-                    warpx_push_ex_f_ckc(j,k,l,Exfab,Ffab,
-                                        betaxy, betaxz, betayx, betayz, betazx, betazy,
-                                        gammax, gammay, gammaz,
-                                        alphax, alphay, alphaz);
+                    warpx_push_ex_yee(j,k,l,Exfab,Byfab,Bzfab,jxfab,mu_c2_dt,dtsdx_c2,dtsdy_c2,dtsdz_c2,dxinv,xmin,nmodes);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l)
                 {
-                    warpx_push_ey_f_ckc(j,k,l,Eyfab,Ffab,
-                                        betaxy, betaxz, betayx, betayz, betazx, betazy,
-                                        gammax, gammay, gammaz,
-                                        alphax, alphay, alphaz);
+                    warpx_push_ey_yee(j,k,l,Eyfab,Bxfab,Bzfab,jyfab,Exfab,mu_c2_dt,dtsdx_c2,dtsdz_c2,xmin,nmodes);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l)
                 {
-                    warpx_push_ez_f_ckc(j,k,l,Ezfab,Ffab,
-                                        betaxy, betaxz, betayx, betayz, betazx, betazy,
-                                        gammax, gammay, gammaz,
-                                        alphax, alphay, alphaz);
+                    warpx_push_ez_yee(j,k,l,Ezfab,Bxfab,Byfab,jzfab,mu_c2_dt,dtsdx_c2,dtsdy_c2,dxinv,xmin,nmodes);
                 });
             }
-        }
 
-        if (cost) {
-            Box cbx = mfi.tilebox(IntVect{AMREX_D_DECL(0,0,0)});
-            if (patch_type == PatchType::coarse) cbx.refine(rr);
-            wt = (amrex::second() - wt) / cbx.d_numPts();
-            auto costfab = cost->array(mfi);
-            amrex::ParallelFor(cbx,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            if (F)
             {
-                costfab(i,j,k) += wt;
-            });
+                auto const& Ffab = F->array(mfi);
+                if (WarpX::maxwell_fdtd_solver_id == 0) {
+                    amrex::ParallelFor(tex, tey, tez,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        warpx_push_ex_f_yee(j,k,l,Exfab,Ffab,dtsdx_c2);
+                    },
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        warpx_push_ey_f_yee(j,k,l,Eyfab,Ffab,dtsdy_c2);
+                    },
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        warpx_push_ez_f_yee(j,k,l,Ezfab,Ffab,dtsdz_c2);
+                    });
+                }
+                else if (WarpX::maxwell_fdtd_solver_id == 1) {
+                    Real betaxy, betaxz, betayx, betayz, betazx, betazy;
+                    Real gammax, gammay, gammaz;
+                    Real alphax, alphay, alphaz;
+                    warpx_calculate_ckc_coefficients(dtsdx_c2, dtsdy_c2, dtsdz_c2,
+                                                     betaxy, betaxz, betayx, betayz, betazx, betazy,
+                                                     gammax, gammay, gammaz,
+                                                     alphax, alphay, alphaz);
+                    amrex::ParallelFor(tex, tey, tez,
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        warpx_push_ex_f_ckc(j,k,l,Exfab,Ffab,
+                                            betaxy, betaxz, betayx, betayz, betazx, betazy,
+                                            gammax, gammay, gammaz,
+                                            alphax, alphay, alphaz);
+                    },
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        warpx_push_ey_f_ckc(j,k,l,Eyfab,Ffab,
+                                            betaxy, betaxz, betayx, betayz, betazx, betazy,
+                                            gammax, gammay, gammaz,
+                                            alphax, alphay, alphaz);
+                    },
+                    [=] AMREX_GPU_DEVICE (int j, int k, int l)
+                    {
+                        warpx_push_ez_f_ckc(j,k,l,Ezfab,Ffab,
+                                            betaxy, betaxz, betayx, betayz, betazx, betazy,
+                                            gammax, gammay, gammaz,
+                                            alphax, alphay, alphaz);
+                    });
+                }
+            }
+        }
+
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            Gpu::synchronize();
+            wt = amrex::second() - wt;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            (*cost)[mfi.index()] += wt;
         }
     }
 
-    if (do_pml && pml[lev]->ok())
+    // The PML fields are pushed once, with the boundary region
+    if (do_pml && pml[lev]->ok() && region != FieldRegion::interior)
     {
         if (F) pml[lev]->ExchangeF(patch_type, F, do_pml_in_domain);
 
@@ -500,6 +585,8 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 #endif
         for ( MFIter mfi(*pml_E[0], TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
+            Real wt = amrex::second();
+
             const Box& tex  = mfi.tilebox(Ex_nodal_flag);
             const Box& tey  = mfi.tilebox(Ey_nodal_flag);
             const Box& tez  = mfi.tilebox(Ez_nodal_flag);
@@ -606,7 +693,22 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 
                }
             }
+
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                Gpu::synchronize();
+                pml[lev]->AddCost(patch_type, mfi.index(), amrex::second() - wt);
+            }
         }
+
+        // The cost of the PML boxes is counted in the adjacent grid boxes
+        if (cost) pml[lev]->TransferCosts(patch_type, *cost);
+    }
+
+    // Wall time of the field solver, to calibrate the heuristic costs
+    if (costs_calibration_nsteps >= 0) {
+        Gpu::synchronize();
+        costs_calibration_fields_time += amrex::second() - wt_fields;
     }
 }
 
@@ -637,6 +739,8 @@ WarpX::EvolveF (int lev, PatchType patch_type, Real a_dt, DtType a_dt_type)
 
     BL_PROFILE("WarpX::EvolveF()");
 
+    const Real wt_fields = amrex::second();
+
     static constexpr Real mu_c2 = PhysConst::mu0*PhysConst::c*PhysConst::c;
 
     const int patch_level = (patch_type == PatchType::fine) ? lev : lev-1;
@@ -695,6 +799,12 @@ WarpX::EvolveF (int lev, PatchType patch_type, Real a_dt, DtType a_dt_type)
 
         }
     }
+
+    // Wall time of the field solver, to calibrate the heuristic costs
+    if (costs_calibration_nsteps >= 0) {
+        Gpu::synchronize();
+        costs_calibration_fields_time += amrex::second() - wt_fields;
+    }
 }
 
 #ifdef WARPX_DIM_RZ
@@ -82,6 +82,13 @@ WarpX::InitData ()
 
 void
 WarpX::InitDiagnostics () {
+    if (async_output) {
+        async_writer.reset(new AsyncWriter(static_cast<long>(async_output_max_mb)*1024*1024));
+    }
+    if (checkpoint_full_int > 1) {
+        incremental_checkpoint.reset(new IncrementalCheckpoint(checkpoint_full_int,
+                                                               checkpoint_delta_threshold));
+    }
     if (do_boosted_frame_diagnostic) {
         const Real* current_lo = geom[0].ProbLo();
         const Real* current_hi = geom[0].ProbHi();
@@ -335,7 +342,9 @@ WarpX::InitLevelData (int lev, Real time)
     }
 
     if (costs[lev]) {
-        costs[lev]->setVal(0.0);
+        for (int i : costs[lev]->IndexArray()) {
+            (*costs[lev])[i] = 0.;
+        }
     }
 }
 
@@ -442,7 +442,7 @@ LaserParticleContainer::Evolve (int lev,
 
     BL_ASSERT(OnSameGrids(lev,jx));
 
-    MultiFab* cost = WarpX::getCosts(lev);
+    LayoutData<Real>* cost = WarpX::getCosts(lev);
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -455,6 +455,8 @@ LaserParticleContainer::Evolve (int lev,
 #endif
 
         Cuda::ManagedDeviceVector<Real> plane_Xp, plane_Yp, amplitude_E;
+        // Time passed to the parsed field function (same for all particles)
+        Cuda::ManagedDeviceVector<Real> plane_t;
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
@@ -514,9 +516,10 @@ LaserParticleContainer::Evolve (int lev,
             }
 
             if (profile == laser_t::parse_field_function) {
-                for (int i = 0; i < np; ++i) {
-                    amplitude_E[i] = parser.eval(plane_Xp[i], plane_Yp[i], t);
-                }
+                plane_t.resize(np);
+                std::fill(plane_t.dataPtr(), plane_t.dataPtr()+np, t);
+                parser.evalBatch(np, plane_Xp.dataPtr(), plane_Yp.dataPtr(),
+                                 plane_t.dataPtr(), amplitude_E.dataPtr());
             }
 
             // Calculate the corresponding momentum and position for the particles
@@ -559,15 +562,14 @@ LaserParticleContainer::Evolve (int lev,
                 }
             }
 
-            if (cost) {
-                const Box& tbx = pti.tilebox();
-                wt = (amrex::second() - wt) / tbx.d_numPts();
-                Array4<Real> const& costarr = cost->array(pti);
-                amrex::ParallelFor(tbx,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                {
-                    costarr(i,j,k) += wt;
-                });
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                Gpu::synchronize();
+                wt = amrex::second() - wt;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+                (*cost)[pti.index()] += wt;
             }
         }
     }
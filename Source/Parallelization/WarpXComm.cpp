@@ -56,13 +56,12 @@ WarpX::UpdateAuxilaryData ()
     {
         const auto& crse_period = Geom(lev-1).periodicity();
         const IntVect& ng = Bfield_cp[lev][0]->nGrowVect();
-        const DistributionMapping& dm = Bfield_cp[lev][0]->DistributionMap();
 
         // B field
         {
-            MultiFab dBx(Bfield_cp[lev][0]->boxArray(), dm, Bfield_cp[lev][0]->nComp(), ng);
-            MultiFab dBy(Bfield_cp[lev][1]->boxArray(), dm, Bfield_cp[lev][1]->nComp(), ng);
-            MultiFab dBz(Bfield_cp[lev][2]->boxArray(), dm, Bfield_cp[lev][2]->nComp(), ng);
+            MultiFab& dBx = *Bfield_aux_diff[lev][0];
+            MultiFab& dBy = *Bfield_aux_diff[lev][1];
+            MultiFab& dBz = *Bfield_aux_diff[lev][2];
             dBx.setVal(0.0);
             dBy.setVal(0.0);
             dBz.setVal(0.0);
@@ -78,46 +77,13 @@ WarpX::UpdateAuxilaryData ()
             MultiFab::Subtract(dBx, *Bfield_cp[lev][0], 0, 0, Bfield_cp[lev][0]->nComp(), ng);
             MultiFab::Subtract(dBy, *Bfield_cp[lev][1], 0, 0, Bfield_cp[lev][1]->nComp(), ng);
             MultiFab::Subtract(dBz, *Bfield_cp[lev][2], 0, 0, Bfield_cp[lev][2]->nComp(), ng);
-
-            const int refinement_ratio = refRatio(lev-1)[0];
-            AMREX_ALWAYS_ASSERT(refinement_ratio == 2);
-
-#ifdef _OPENMP
-#pragma omp parallel if (Gpu::notInLaunchRegion())
-#endif
-            for (MFIter mfi(*Bfield_aux[lev][0]); mfi.isValid(); ++mfi)
-            {
-                Array4<Real> const& bx_aux = Bfield_aux[lev][0]->array(mfi);
-                Array4<Real> const& by_aux = Bfield_aux[lev][1]->array(mfi);
-                Array4<Real> const& bz_aux = Bfield_aux[lev][2]->array(mfi);
-                Array4<Real const> const& bx_fp = Bfield_fp[lev][0]->const_array(mfi);
-                Array4<Real const> const& by_fp = Bfield_fp[lev][1]->const_array(mfi);
-                Array4<Real const> const& bz_fp = Bfield_fp[lev][2]->const_array(mfi);
-                Array4<Real const> const& bx_c = dBx.const_array(mfi);
-                Array4<Real const> const& by_c = dBy.const_array(mfi);
-                Array4<Real const> const& bz_c = dBz.const_array(mfi);
-
-                amrex::ParallelFor(Box(bx_aux), Box(by_aux), Box(bz_aux),
-                [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
-                {
-                    warpx_interp_bfield_x(j,k,l, bx_aux, bx_fp, bx_c);
-                },
-                [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
-                {
-                    warpx_interp_bfield_y(j,k,l, by_aux, by_fp, by_c);
-                },
-                [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
-                {
-                    warpx_interp_bfield_z(j,k,l, bz_aux, bz_fp, bz_c);
-                });
-            }
         }
 
         // E field
         {
-            MultiFab dEx(Efield_cp[lev][0]->boxArray(), dm, Efield_cp[lev][0]->nComp(), ng);
-            MultiFab dEy(Efield_cp[lev][1]->boxArray(), dm, Efield_cp[lev][1]->nComp(), ng);
-            MultiFab dEz(Efield_cp[lev][2]->boxArray(), dm, Efield_cp[lev][2]->nComp(), ng);
+            MultiFab& dEx = *Efield_aux_diff[lev][0];
+            MultiFab& dEy = *Efield_aux_diff[lev][1];
+            MultiFab& dEz = *Efield_aux_diff[lev][2];
             dEx.setVal(0.0);
             dEy.setVal(0.0);
             dEz.setVal(0.0);
@@ -133,36 +99,72 @@ WarpX::UpdateAuxilaryData ()
             MultiFab::Subtract(dEx, *Efield_cp[lev][0], 0, 0, Efield_cp[lev][0]->nComp(), ng);
             MultiFab::Subtract(dEy, *Efield_cp[lev][1], 0, 0, Efield_cp[lev][1]->nComp(), ng);
             MultiFab::Subtract(dEz, *Efield_cp[lev][2], 0, 0, Efield_cp[lev][2]->nComp(), ng);
+        }
 
-#ifdef _OPEMP
+        const int refinement_ratio = refRatio(lev-1)[0];
+        AMREX_ALWAYS_ASSERT(refinement_ratio == 2);
+
+        // Interpolate B and E in the same tiled loop
+        const IntVect& ng_aux = Bfield_aux[lev][0]->nGrowVect();
+#ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-            for (MFIter mfi(*Efield_aux[lev][0]); mfi.isValid(); ++mfi)
+        for (MFIter mfi(*Bfield_aux[lev][0], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& tbx = mfi.tilebox(Bfield_aux[lev][0]->ixType().toIntVect(), ng_aux);
+            const Box& tby = mfi.tilebox(Bfield_aux[lev][1]->ixType().toIntVect(), ng_aux);
+            const Box& tbz = mfi.tilebox(Bfield_aux[lev][2]->ixType().toIntVect(), ng_aux);
+            const Box& tex = mfi.tilebox(Efield_aux[lev][0]->ixType().toIntVect(), ng_aux);
+            const Box& tey = mfi.tilebox(Efield_aux[lev][1]->ixType().toIntVect(), ng_aux);
+            const Box& tez = mfi.tilebox(Efield_aux[lev][2]->ixType().toIntVect(), ng_aux);
+
+            Array4<Real> const& bx_aux = Bfield_aux[lev][0]->array(mfi);
+            Array4<Real> const& by_aux = Bfield_aux[lev][1]->array(mfi);
+            Array4<Real> const& bz_aux = Bfield_aux[lev][2]->array(mfi);
+            Array4<Real const> const& bx_fp = Bfield_fp[lev][0]->const_array(mfi);
+            Array4<Real const> const& by_fp = Bfield_fp[lev][1]->const_array(mfi);
+            Array4<Real const> const& bz_fp = Bfield_fp[lev][2]->const_array(mfi);
+            Array4<Real const> const& bx_c = Bfield_aux_diff[lev][0]->const_array(mfi);
+            Array4<Real const> const& by_c = Bfield_aux_diff[lev][1]->const_array(mfi);
+            Array4<Real const> const& bz_c = Bfield_aux_diff[lev][2]->const_array(mfi);
+
+            Array4<Real> const& ex_aux = Efield_aux[lev][0]->array(mfi);
+            Array4<Real> const& ey_aux = Efield_aux[lev][1]->array(mfi);
+            Array4<Real> const& ez_aux = Efield_aux[lev][2]->array(mfi);
+            Array4<Real const> const& ex_fp = Efield_fp[lev][0]->const_array(mfi);
+            Array4<Real const> const& ey_fp = Efield_fp[lev][1]->const_array(mfi);
+            Array4<Real const> const& ez_fp = Efield_fp[lev][2]->const_array(mfi);
+            Array4<Real const> const& ex_c = Efield_aux_diff[lev][0]->const_array(mfi);
+            Array4<Real const> const& ey_c = Efield_aux_diff[lev][1]->const_array(mfi);
+            Array4<Real const> const& ez_c = Efield_aux_diff[lev][2]->const_array(mfi);
+
+            amrex::ParallelFor(tbx, tby, tbz,
+            [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
             {
-                Array4<Real> const& ex_aux = Efield_aux[lev][0]->array(mfi);
-                Array4<Real> const& ey_aux = Efield_aux[lev][1]->array(mfi);
-                Array4<Real> const& ez_aux = Efield_aux[lev][2]->array(mfi);
-                Array4<Real const> const& ex_fp = Efield_fp[lev][0]->const_array(mfi);
-                Array4<Real const> const& ey_fp = Efield_fp[lev][1]->const_array(mfi);
-                Array4<Real const> const& ez_fp = Efield_fp[lev][2]->const_array(mfi);
-                Array4<Real const> const& ex_c = dEx.const_array(mfi);
-                Array4<Real const> const& ey_c = dEy.const_array(mfi);
-                Array4<Real const> const& ez_c = dEz.const_array(mfi);
-
-                amrex::ParallelFor(Box(ex_aux), Box(ey_aux), Box(ez_aux),
-                [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
-                {
-                    warpx_interp_efield_x(j,k,l, ex_aux, ex_fp, ex_c);
-                },
-                [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
-                {
-                    warpx_interp_efield_y(j,k,l, ey_aux, ey_fp, ey_c);
-                },
-                [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
-                {
-                    warpx_interp_efield_z(j,k,l, ez_aux, ez_fp, ez_c);
-                });
-            }
+                warpx_interp_bfield_x(j,k,l, bx_aux, bx_fp, bx_c);
+            },
+            [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
+            {
+                warpx_interp_bfield_y(j,k,l, by_aux, by_fp, by_c);
+            },
+            [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
+            {
+                warpx_interp_bfield_z(j,k,l, bz_aux, bz_fp, bz_c);
+            });
+
+            amrex::ParallelFor(tex, tey, tez,
+            [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
+            {
+                warpx_interp_efield_x(j,k,l, ex_aux, ex_fp, ex_c);
+            },
+            [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
+            {
+                warpx_interp_efield_y(j,k,l, ey_aux, ey_fp, ey_c);
+            },
+            [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
+            {
+                warpx_interp_efield_z(j,k,l, ez_aux, ez_fp, ez_c);
+            });
         }
     }
 }
@@ -204,79 +206,142 @@ WarpX::FillBoundaryE(int lev)
 void
 WarpX::FillBoundaryE (int lev, PatchType patch_type)
 {
-    if (patch_type == PatchType::fine)
+    FillBoundaryFields(lev, patch_type, true, false, false);
+}
+
+void
+WarpX::FillBoundaryB (int lev)
+{
+    FillBoundaryB(lev, PatchType::fine);
+    if (lev > 0) FillBoundaryB(lev, PatchType::coarse);
+}
+
+void
+WarpX::FillBoundaryB (int lev, PatchType patch_type)
+{
+    FillBoundaryFields(lev, patch_type, false, true, false);
+}
+
+void
+WarpX::FillBoundaryEB ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
     {
-        if (do_pml && pml[lev]->ok())
-        {
+        FillBoundaryFields_nowait(lev, PatchType::fine, true, true, false);
+        if (lev > 0) FillBoundaryFields_nowait(lev, PatchType::coarse, true, true, false);
+    }
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        FillBoundaryFields_finish(lev, PatchType::fine, true, true, false);
+        if (lev > 0) FillBoundaryFields_finish(lev, PatchType::coarse, true, true, false);
+    }
+}
+
+void
+WarpX::FillBoundaryFields (int lev, PatchType patch_type, bool fill_E, bool fill_B, bool fill_F)
+{
+    FillBoundaryFields_nowait(lev, patch_type, fill_E, fill_B, fill_F);
+    FillBoundaryFields_finish(lev, patch_type, fill_E, fill_B, fill_F);
+}
+
+void
+WarpX::FillBoundaryFields_nowait (int lev, PatchType patch_type,
+                                  bool fill_E, bool fill_B, bool fill_F)
+{
+    const bool fine = (patch_type == PatchType::fine);
+    const auto& Efield = fine ? Efield_fp[lev] : Efield_cp[lev];
+    const auto& Bfield = fine ? Bfield_fp[lev] : Bfield_cp[lev];
+    MultiFab* F = fine ? F_fp[lev].get() : F_cp[lev].get();
+    fill_F = fill_F && F;
+
+    // The exchanges with the PML (blocking) modify the guard cells of the
+    // fields and the PML fields: they are done before any guard cell
+    // exchange is posted.
+    if (do_pml && pml[lev]->ok())
+    {
+        if (fill_E) {
             pml[lev]->ExchangeE(patch_type,
-                              { Efield_fp[lev][0].get(),
-                                Efield_fp[lev][1].get(),
-                                Efield_fp[lev][2].get() },
+                                { Efield[0].get(), Efield[1].get(), Efield[2].get() },
+                                do_pml_in_domain);
+        }
+        if (fill_B) {
+            pml[lev]->ExchangeB(patch_type,
+                                { Bfield[0].get(), Bfield[1].get(), Bfield[2].get() },
                                 do_pml_in_domain);
-            pml[lev]->FillBoundaryE(patch_type);
         }
+        if (fill_F) {
+            pml[lev]->ExchangeF(patch_type, F, do_pml_in_domain);
+        }
+        pml[lev]->FillBoundary_nowait(patch_type, fill_E, fill_B, fill_F);
+    }
 
-        const auto& period = Geom(lev).periodicity();
-        Vector<MultiFab*> mf{Efield_fp[lev][0].get(),Efield_fp[lev][1].get(),Efield_fp[lev][2].get()};
-        amrex::FillBoundary(mf, period);
+    const auto& period = fine ? Geom(lev).periodicity() : Geom(lev-1).periodicity();
+    for (int i = 0; i < 3; ++i) {
+        if (fill_E) Efield[i]->FillBoundary_nowait(period);
+        if (fill_B) Bfield[i]->FillBoundary_nowait(period);
     }
-    else if (patch_type == PatchType::coarse)
+    if (fill_F) F->FillBoundary_nowait(period);
+}
+
+void
+WarpX::FillBoundaryFields_finish (int lev, PatchType patch_type,
+                                  bool fill_E, bool fill_B, bool fill_F)
+{
+    const bool fine = (patch_type == PatchType::fine);
+    const auto& Efield = fine ? Efield_fp[lev] : Efield_cp[lev];
+    const auto& Bfield = fine ? Bfield_fp[lev] : Bfield_cp[lev];
+    MultiFab* F = fine ? F_fp[lev].get() : F_cp[lev].get();
+    fill_F = fill_F && F;
+
+    if (do_pml && pml[lev]->ok())
     {
-        if (do_pml && pml[lev]->ok())
-        {
-        pml[lev]->ExchangeE(patch_type,
-                            { Efield_cp[lev][0].get(),
-                              Efield_cp[lev][1].get(),
-                              Efield_cp[lev][2].get() },
-                              do_pml_in_domain);
-        pml[lev]->FillBoundaryE(patch_type);
-        }
+        pml[lev]->FillBoundary_finish(patch_type, fill_E, fill_B, fill_F);
+    }
 
-        const auto& cperiod = Geom(lev-1).periodicity();
-        Vector<MultiFab*> mf{Efield_cp[lev][0].get(),Efield_cp[lev][1].get(),Efield_cp[lev][2].get()};
-        amrex::FillBoundary(mf, cperiod);
+    for (int i = 0; i < 3; ++i) {
+        if (fill_E) Efield[i]->FillBoundary_finish();
+        if (fill_B) Bfield[i]->FillBoundary_finish();
     }
+    if (fill_F) F->FillBoundary_finish();
 }
 
 void
-WarpX::FillBoundaryB (int lev)
+WarpX::FillBoundaryE_nowait ()
 {
-    FillBoundaryB(lev, PatchType::fine);
-    if (lev > 0) FillBoundaryB(lev, PatchType::coarse);
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        FillBoundaryFields_nowait(lev, PatchType::fine, true, false, false);
+        if (lev > 0) FillBoundaryFields_nowait(lev, PatchType::coarse, true, false, false);
+    }
 }
 
 void
-WarpX::FillBoundaryB (int lev, PatchType patch_type)
+WarpX::FillBoundaryE_finish ()
 {
-    if (patch_type == PatchType::fine)
+    for (int lev = 0; lev <= finest_level; ++lev)
     {
-        if (do_pml && pml[lev]->ok())
-        {
-            pml[lev]->ExchangeB(patch_type,
-                            { Bfield_fp[lev][0].get(),
-                              Bfield_fp[lev][1].get(),
-                              Bfield_fp[lev][2].get() },
-                              do_pml_in_domain);
-        pml[lev]->FillBoundaryB(patch_type);
-        }
-        const auto& period = Geom(lev).periodicity();
-        Vector<MultiFab*> mf{Bfield_fp[lev][0].get(),Bfield_fp[lev][1].get(),Bfield_fp[lev][2].get()};
-        amrex::FillBoundary(mf, period);
+        FillBoundaryFields_finish(lev, PatchType::fine, true, false, false);
+        if (lev > 0) FillBoundaryFields_finish(lev, PatchType::coarse, true, false, false);
     }
-    else if (patch_type == PatchType::coarse)
+}
+
+void
+WarpX::FillBoundaryB_nowait ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
     {
-        if (do_pml && pml[lev]->ok())
-        {
-        pml[lev]->ExchangeB(patch_type,
-                      { Bfield_cp[lev][0].get(),
-                        Bfield_cp[lev][1].get(),
-                        Bfield_cp[lev][2].get() },
-                        do_pml_in_domain);
-        pml[lev]->FillBoundaryB(patch_type);
-        }
-        const auto& cperiod = Geom(lev-1).periodicity();
-        Vector<MultiFab*> mf{Bfield_cp[lev][0].get(),Bfield_cp[lev][1].get(),Bfield_cp[lev][2].get()};
-        amrex::FillBoundary(mf, cperiod);
+        FillBoundaryFields_nowait(lev, PatchType::fine, false, true, false);
+        if (lev > 0) FillBoundaryFields_nowait(lev, PatchType::coarse, false, true, false);
+    }
+}
+
+void
+WarpX::FillBoundaryB_finish ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        FillBoundaryFields_finish(lev, PatchType::fine, false, true, false);
+        if (lev > 0) FillBoundaryFields_finish(lev, PatchType::coarse, false, true, false);
     }
 }
 
@@ -290,30 +355,7 @@ WarpX::FillBoundaryF (int lev)
 void
 WarpX::FillBoundaryF (int lev, PatchType patch_type)
 {
-    if (patch_type == PatchType::fine && F_fp[lev])
-    {
-        if (do_pml && pml[lev]->ok())
-        {
-            pml[lev]->ExchangeF(patch_type, F_fp[lev].get(),
-                                do_pml_in_domain);
-            pml[lev]->FillBoundaryF(patch_type);
-        }
-
-        const auto& period = Geom(lev).periodicity();
-        F_fp[lev]->FillBoundary(period);
-    }
-    else if (patch_type == PatchType::coarse && F_cp[lev])
-    {
-        if (do_pml && pml[lev]->ok())
-        {
-        pml[lev]->ExchangeF(patch_type, F_cp[lev].get(),
-                            do_pml_in_domain);
-        pml[lev]->FillBoundaryF(patch_type);
-        }
-
-        const auto& cperiod = Geom(lev-1).periodicity();
-        F_cp[lev]->FillBoundary(cperiod);
-    }
+    FillBoundaryFields(lev, patch_type, false, false, true);
 }
 
 void
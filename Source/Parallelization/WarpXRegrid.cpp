@@ -2,28 +2,337 @@
 #include <WarpX.H>
 #include <AMReX_BLProfiler.H>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace amrex;
 
+void
+WarpX::CheckLoadBalance (int step)
+{
+    BL_PROFILE("WarpX::CheckLoadBalance()");
+
+    // The heuristic costs are only used once their weights are calibrated
+    if (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Heuristic and
+        not CalibrateCostsHeuristic()) return;
+
+    if (not load_balance_adaptive)
+    {
+        if (step > 0 && (step+1) % load_balance_int == 0)
+        {
+            LoadBalance();
+            ResetCosts();
+        }
+    }
+    else if (load_balance_costs_weight > 0.)
+    {
+        // Imbalance of the current distribution: max/mean cost per MPI rank
+        Real max_cost = 0.;
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            for (int i : costs[lev]->IndexArray()) {
+                max_cost += (*costs[lev])[i];
+            }
+        }
+        Real mean_cost = max_cost;
+        ParallelDescriptor::ReduceRealMax(max_cost);
+        ParallelDescriptor::ReduceRealSum(mean_cost);
+        const int nprocs = ParallelDescriptor::NProcs();
+        mean_cost /= nprocs;
+        const Real imbalance = (mean_cost > 0.) ? max_cost/mean_cost : 1.;
+
+        // The distribution is evaluated at most every load_balance_int steps,
+        // so that the costs are averaged over enough steps
+        if (load_balance_steps >= load_balance_int)
+        {
+            load_balance_steps = 0;
+            if (imbalance <= load_balance_threshold)
+            {
+                if (verbose) {
+                    amrex::Print() << "Load balance: imbalance " << imbalance
+                                   << " (max/mean cost per rank) below threshold\n";
+                }
+            }
+            else
+            {
+                // New distribution, and predicted max cost per MPI rank
+                Vector<DistributionMapping> newdm(finest_level+1);
+                Vector<Real> rank_cost(nprocs, 0.);
+                for (int lev = 0; lev <= finest_level; ++lev)
+                {
+                    const Vector<Real> box_cost = GatherCosts(lev);
+                    newdm[lev] = LoadBalanceDistributionMap(lev, box_cost);
+                    for (int i = 0, nboxes = box_cost.size(); i < nboxes; ++i) {
+                        rank_cost[newdm[lev][i]] += box_cost[i];
+                    }
+                }
+                const Real new_max_cost = *std::max_element(rank_cost.begin(), rank_cost.end());
+
+                // Wall time saved over the next steps (until the next
+                // evaluation), compared with the time of the last
+                // redistribution. (The costs are a running sum with total
+                // weight load_balance_costs_weight, in seconds.)
+                const int nsteps = std::max(std::min(load_balance_int, max_step - step), 0);
+                const Real gain = (max_cost - new_max_cost)/load_balance_costs_weight * nsteps;
+                const bool do_load_balance = (gain > load_balance_redistribution_time);
+
+                if (verbose) {
+                    amrex::Print() << "Load balance: imbalance " << imbalance
+                                   << " (max/mean cost per rank), predicted " << new_max_cost/mean_cost
+                                   << "; gain " << gain << " s over " << nsteps
+                                   << " steps vs. " << load_balance_redistribution_time
+                                   << " s to redistribute: "
+                                   << (do_load_balance ? "redistributing" : "not redistributing")
+                                   << "\n";
+                }
+
+                if (do_load_balance)
+                {
+                    LoadBalance(newdm);
+                    ResetCosts();
+                }
+            }
+        }
+    }
+
+    // Perform running average of the costs
+    // (Giving more importance to most recent costs)
+    const Real decay = 1. - 2./load_balance_int;
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        for (int i : costs[lev]->IndexArray()) {
+            (*costs[lev])[i] *= decay;
+        }
+    }
+    // The costs of this step are added with weight 1: measured during the
+    // step with the timers, or computed now with the heuristic
+    load_balance_costs_weight = load_balance_costs_weight*decay + 1.;
+    ++load_balance_steps;
+    if (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Heuristic) {
+        UpdateCostsHeuristic();
+    }
+}
+
+void
+WarpX::ResetCosts ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        for (int i : costs[lev]->IndexArray()) {
+            (*costs[lev])[i] = 0.;
+        }
+    }
+    load_balance_costs_weight = 0.;
+}
+
+void
+WarpX::UpdateCostsHeuristic ()
+{
+    BL_PROFILE("WarpX::UpdateCostsHeuristic()");
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        LayoutData<Real>& cost = *costs[lev];
+
+        // Cells of the fine patch and coarse patch
+        const BoxArray& ba = boxArray(lev);
+        for (int i : cost.IndexArray()) {
+            Real ncells = ba[i].d_numPts();
+            if (lev > 0) ncells += amrex::coarsen(ba[i], refRatio(lev-1)).d_numPts();
+            cost[i] += costs_heuristic_cells_wt * ncells;
+        }
+
+        mypc->AddParticleCosts(lev, cost, costs_heuristic_particles_wt);
+
+        // Cells of the PML, counted in the adjacent grid boxes
+        if (do_pml && pml[lev]->ok())
+        {
+            pml[lev]->AddCellCosts(PatchType::fine, costs_heuristic_cells_wt);
+            pml[lev]->TransferCosts(PatchType::fine, cost);
+            if (lev > 0) {
+                pml[lev]->AddCellCosts(PatchType::coarse, costs_heuristic_cells_wt);
+                pml[lev]->TransferCosts(PatchType::coarse, cost);
+            }
+        }
+    }
+}
+
+bool
+WarpX::CalibrateCostsHeuristic ()
+{
+    const int ncontainers = mypc->nContainers();
+    if (not costs_heuristic_particles_wt.empty() and
+        static_cast<int>(costs_heuristic_particles_wt.size()) != ncontainers)
+    {
+        amrex::Abort("warpx.costs_heuristic_particles_wt must have one value per species and laser");
+    }
+    const bool calibrate_cells = (costs_heuristic_cells_wt < 0.);
+    const bool calibrate_particles = costs_heuristic_particles_wt.empty();
+    if (not calibrate_cells and not calibrate_particles) return true;
+
+    if (costs_calibration_nsteps < 0)
+    {
+        // Start measuring the next steps
+        costs_calibration_nsteps = 0;
+        costs_calibration_fields_time = 0.;
+        costs_calibration_ncells = 0.;
+        costs_calibration_nparticles.assign(ncontainers, 0.);
+        mypc->StartEvolveTimers();
+        return false;
+    }
+
+    // Number of cells and particles on this MPI rank, during the step
+    // that was just measured
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        const BoxArray& ba = boxArray(lev);
+        for (int i : costs[lev]->IndexArray()) {
+            costs_calibration_ncells += ba[i].d_numPts();
+            if (lev > 0) costs_calibration_ncells += amrex::coarsen(ba[i], refRatio(lev-1)).d_numPts();
+        }
+        if (do_pml && pml[lev]->ok()) {
+            costs_calibration_ncells += pml[lev]->NumLocalCells(PatchType::fine);
+            if (lev > 0) costs_calibration_ncells += pml[lev]->NumLocalCells(PatchType::coarse);
+        }
+    }
+    for (int i = 0; i < ncontainers; ++i) {
+        costs_calibration_nparticles[i] +=
+            mypc->GetParticleContainer(i).TotalNumberOfParticles(true, true);
+    }
+    ++costs_calibration_nsteps;
+    if (costs_calibration_nsteps < costs_heuristic_calibration_steps) return false;
+
+    // Wall time per cell and per particle (summed over the MPI ranks)
+    const Vector<Real> evolve_time = mypc->StopEvolveTimers();
+    Vector<Real> sums;
+    sums.push_back(costs_calibration_fields_time);
+    sums.push_back(costs_calibration_ncells);
+    sums.insert(sums.end(), evolve_time.begin(), evolve_time.end());
+    sums.insert(sums.end(), costs_calibration_nparticles.begin(), costs_calibration_nparticles.end());
+    ParallelDescriptor::ReduceRealSum(sums.dataPtr(), sums.size());
+
+    if (calibrate_cells) {
+        costs_heuristic_cells_wt = (sums[1] > 0.) ? sums[0]/sums[1] : 0.;
+    }
+    if (calibrate_particles)
+    {
+        // Species without particles during the calibration get the mean
+        // weight of the other species
+        costs_heuristic_particles_wt.assign(ncontainers, -1.);
+        Real mean_wt = 0.;
+        int ncalibrated = 0;
+        for (int i = 0; i < ncontainers; ++i) {
+            const Real np = sums[2+ncontainers+i];
+            if (np > 0.) {
+                costs_heuristic_particles_wt[i] = sums[2+i]/np;
+                mean_wt += costs_heuristic_particles_wt[i];
+                ++ncalibrated;
+            }
+        }
+        if (ncalibrated > 0) mean_wt /= ncalibrated;
+        for (auto& wt : costs_heuristic_particles_wt) {
+            if (wt < 0.) wt = mean_wt;
+        }
+    }
+    costs_calibration_nsteps = -1;
+
+    if (verbose) {
+        amrex::Print() << "Load balance: heuristic costs calibrated: "
+                       << costs_heuristic_cells_wt << " s per cell, particles:";
+        for (const auto& wt : costs_heuristic_particles_wt) {
+            amrex::Print() << " " << wt;
+        }
+        amrex::Print() << " s per particle\n";
+    }
+
+    return true;
+}
+
+Vector<Real>
+WarpX::GatherCosts (int lev) const
+{
+    Vector<Real> box_cost(costs[lev]->size(), 0.);
+    for (int i : costs[lev]->IndexArray()) {
+        box_cost[i] = (*costs[lev])[i];
+    }
+    ParallelDescriptor::ReduceRealSum(box_cost.dataPtr(), box_cost.size());
+    return box_cost;
+}
+
+DistributionMapping
+WarpX::LoadBalanceDistributionMap (int lev, const Vector<Real>& box_cost) const
+{
+    // Integer weights for the knapsack and SFC algorithms, as in
+    // DistributionMapping::makeKnapSack
+    const Real wmax = *std::max_element(box_cost.begin(), box_cost.end());
+    const Real scale = (wmax == 0.) ? 1.e9 : 1.e9/wmax;
+    std::vector<long> wgts(box_cost.size());
+    for (int i = 0, nboxes = box_cost.size(); i < nboxes; ++i) {
+        wgts[i] = static_cast<long>(box_cost[i]*scale) + 1L;
+    }
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    DistributionMapping newdm;
+    if (load_balance_with_sfc) {
+        newdm.SFCProcessorMap(boxArray(lev), wgts, nprocs, false);
+    } else {
+        const Real nboxes = box_cost.size();
+        const int nmax = static_cast<int>(std::ceil(nboxes/nprocs*load_balance_knapsack_factor));
+        Real efficiency;
+        newdm.KnapSackProcessorMap(wgts, nprocs, &efficiency, true, nmax);
+    }
+    return newdm;
+}
+
+Vector<DistributionMapping>
+WarpX::LoadBalanceDistributionMaps () const
+{
+    Vector<DistributionMapping> newdm(finestLevel()+1);
+    for (int lev = 0; lev <= finestLevel(); ++lev) {
+        newdm[lev] = LoadBalanceDistributionMap(lev, GatherCosts(lev));
+    }
+    return newdm;
+}
+
 void
 WarpX::LoadBalance ()
+{
+    AMREX_ALWAYS_ASSERT(costs[0] != nullptr);
+
+    LoadBalance(LoadBalanceDistributionMaps());
+}
+
+void
+WarpX::LoadBalance (const Vector<DistributionMapping>& newdm)
 {
     BL_PROFILE_REGION("LoadBalance");
     BL_PROFILE("WarpX::LoadBalance()");
 
-    AMREX_ALWAYS_ASSERT(costs[0] != nullptr);
+    Real wt = amrex::second();
 
     for (int lev = 0; lev <= finestLevel(); ++lev)
     {
-        const Real nboxes = costs[lev]->size();
-        const Real nprocs = ParallelDescriptor::NProcs();
-        const int nmax = static_cast<int>(std::ceil(nboxes/nprocs*load_balance_knapsack_factor));
-        const DistributionMapping newdm = (load_balance_with_sfc)
-            ? DistributionMapping::makeSFC(*costs[lev], false)
-            : DistributionMapping::makeKnapSack(*costs[lev], nmax);
-        RemakeLevel(lev, t_new[lev], boxArray(lev), newdm);
+        RemakeLevel(lev, t_new[lev], boxArray(lev), newdm[lev]);
+    }
+
+    // The PML boxes are distributed with their adjacent grid boxes:
+    // rebuild the PML with the new distribution of the grids
+    if (do_pml)
+    {
+        Vector<std::unique_ptr<PML> > old_pml(finestLevel()+1);
+        for (int lev = 0; lev <= finestLevel(); ++lev) {
+            old_pml[lev] = std::move(pml[lev]);
+        }
+        InitPML();
+        for (int lev = 0; lev <= finestLevel(); ++lev) {
+            pml[lev]->CopyFieldsFrom(*old_pml[lev]);
+        }
+        ComputePMLFactors();
     }
 
     mypc->Redistribute();
+
+    // Used to decide whether the next redistributions are worth it
+    wt = amrex::second() - wt;
+    ParallelDescriptor::ReduceRealMax(wt);
+    load_balance_redistribution_time = wt;
 }
 
 void
@@ -142,6 +451,20 @@ WarpX::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMa
                                                                        dm, current_cp[lev][idim]->nComp(), ng));
                     current_cp[lev][idim] = std::move(pmf);
                 }
+                {
+                    const IntVect& ng = Bfield_aux_diff[lev][idim]->nGrowVect();
+                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Bfield_aux_diff[lev][idim]->boxArray(),
+                                                                      dm, Bfield_aux_diff[lev][idim]->nComp(), ng));
+                    // no need to redistribute: scratch space
+                    Bfield_aux_diff[lev][idim] = std::move(pmf);
+                }
+                {
+                    const IntVect& ng = Efield_aux_diff[lev][idim]->nGrowVect();
+                    auto pmf = std::unique_ptr<MultiFab>(new MultiFab(Efield_aux_diff[lev][idim]->boxArray(),
+                                                                      dm, Efield_aux_diff[lev][idim]->nComp(), ng));
+                    // no need to redistribute: scratch space
+                    Efield_aux_diff[lev][idim] = std::move(pmf);
+                }
             }
 
             if (F_cp[lev] != nullptr) {
@@ -216,9 +539,24 @@ WarpX::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMa
         }
 
         if (costs[lev] != nullptr) {
-            costs[lev].reset(new MultiFab(costs[lev]->boxArray(), dm, 1, 0));
-            costs[lev]->setVal(0.0);
+            costs[lev].reset(new LayoutData<Real>(costs[lev]->boxArray(), dm));
+        }
+
+#ifdef WARPX_USE_PSATD
+        // Rebuild the spectral solvers on the new DistributionMapping
+        // (the fields in spectral space are recomputed from the fields in
+        // real space at each step, so they do not need to be moved)
+        if (spectral_solver_fp[lev] != nullptr) {
+            AllocLevelSpectralSolver(spectral_solver_fp, lev, ba, dm,
+                                     Efield_fp[lev][0]->nGrowVect(), CellSize(lev));
+        }
+        if (lev > 0 && spectral_solver_cp[lev] != nullptr) {
+            BoxArray cba = ba;
+            cba.coarsen(refRatio(lev-1));
+            AllocLevelSpectralSolver(spectral_solver_cp, lev, cba, dm,
+                                     Efield_cp[lev][0]->nGrowVect(), CellSize(lev-1));
         }
+#endif
 
         SetDistributionMap(lev, dm);
     }
@@ -38,6 +38,7 @@ GpuParser::GpuParser (WarpXParser const& wp)
 #endif // _OPENMP
 
     m_parser = ::new struct wp_parser*[nthreads];
+    m_bytecode = ::new ParserBytecode[nthreads];
     m_var = ::new amrex::XDim3[nthreads];
 
     for (int tid = 0; tid < nthreads; ++tid)
@@ -50,6 +51,7 @@ GpuParser::GpuParser (WarpXParser const& wp)
         wp_parser_regvar(m_parser[tid], "x", &(m_var[tid].x));
         wp_parser_regvar(m_parser[tid], "y", &(m_var[tid].y));
         wp_parser_regvar(m_parser[tid], "z", &(m_var[tid].z));
+        m_bytecode[tid].compile(m_parser[tid]->ast, {"x", "y", "z"});
     }
 
 #endif // AMREX_USE_GPU
@@ -67,7 +69,33 @@ GpuParser::clear ()
         wp_parser_delete(m_parser[tid]);
     }
     ::delete[] m_parser;
+    ::delete[] m_bytecode;
     ::delete[] m_var;
 #endif
 }
 
+void
+GpuParser::evalBatch (int n, amrex::Real const* x, amrex::Real const* y,
+                      amrex::Real const* z, amrex::Real* out) const
+{
+#ifdef AMREX_USE_GPU
+    for (int i = 0; i < n; ++i) {
+        out[i] = (*this)(x[i], y[i], z[i]);
+    }
+#else
+#ifdef _OPENMP
+    int tid = omp_get_thread_num();
+#else
+    int tid = 0;
+#endif
+    if (m_bytecode[tid].ok()) {
+        amrex::Real const* vars[3] = {x, y, z};
+        m_bytecode[tid].eval(n, vars, out);
+    } else {
+        for (int i = 0; i < n; ++i) {
+            out[i] = (*this)(x[i], y[i], z[i]);
+        }
+    }
+#endif
+}
+
@@ -0,0 +1,381 @@
+#include "ParserBytecode.H"
+
+#include <AMReX_Extension.H>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+using amrex::Real;
+
+namespace {
+
+// Compile the AST to instructions on values (variables, constants and
+// results of other instructions), folding the constants and reusing
+// the instructions that have already been emitted.
+struct Compiler
+{
+    enum Kind { Variable, Constant, Temporary };
+
+    struct Value
+    {
+        Kind kind;
+        int index;  // index of the variable, constant or instruction
+    };
+
+    struct Op
+    {
+        enum wp_node_t op;
+        int f;
+        int a;  // values of the arguments
+        int b;
+    };
+
+    Compiler (std::vector<std::string> const& a_names)
+        : names(a_names)
+    {
+        for (int j = 0; j < names.size(); ++j) {
+            values.push_back({Variable, j});
+        }
+    }
+
+    int variable (char const* name)
+    {
+        for (int j = 0; j < names.size(); ++j) {
+            if (names[j] == name) return j;
+        }
+        ok = false;
+        return constant(0.0);
+    }
+
+    int constant (Real v)
+    {
+        // Compare the bits, so that e.g. 0.0 and -0.0 are different constants
+        for (int k = 0; k < constants.size(); ++k) {
+            if (std::memcmp(&constants[k], &v, sizeof(Real)) == 0) return constant_ids[k];
+        }
+        const int id = values.size();
+        values.push_back({Constant, static_cast<int>(constants.size())});
+        constants.push_back(v);
+        constant_ids.push_back(id);
+        return id;
+    }
+
+    bool isConstant (int id) const
+    {
+        return values[id].kind == Constant;
+    }
+
+    Real constantValue (int id) const
+    {
+        return constants[values[id].index];
+    }
+
+    static Real apply (enum wp_node_t op, int f, Real a, Real b)
+    {
+        switch (op)
+        {
+        case WP_ADD: return a + b;
+        case WP_SUB: return a - b;
+        case WP_MUL: return a * b;
+        case WP_DIV: return a / b;
+        case WP_NEG: return -a;
+        case WP_F1:  return wp_call_f1(static_cast<enum wp_f1_t>(f), a);
+        default:     return wp_call_f2(static_cast<enum wp_f2_t>(f), a, b);
+        }
+    }
+
+    static bool commutative (enum wp_node_t op, int f)
+    {
+        return op == WP_ADD or op == WP_MUL or
+            (op == WP_F2 and (f == WP_EQ or f == WP_NEQ or f == WP_AND or f == WP_OR));
+    }
+
+    int emit (enum wp_node_t op, int f, int a, int b)
+    {
+        if (isConstant(a) and (b < 0 or isConstant(b))) {
+            return constant(apply(op, f, constantValue(a), (b < 0) ? 0.0 : constantValue(b)));
+        }
+        if (b >= 0 and a > b and commutative(op, f)) {
+            std::swap(a, b);
+        }
+        const auto key = std::make_tuple(static_cast<int>(op), f, a, b);
+        auto it = cse.find(key);
+        if (it != cse.end()) return it->second;
+        const int id = values.size();
+        values.push_back({Temporary, static_cast<int>(code.size())});
+        code.push_back({op, f, a, b});
+        cse[key] = id;
+        return id;
+    }
+
+    int compile (struct wp_node* node)
+    {
+        switch (node->type)
+        {
+        case WP_NUMBER:
+            return constant(((struct wp_number*)node)->value);
+        case WP_SYMBOL:
+            return variable(((struct wp_symbol*)node)->name);
+        case WP_ADD:
+        case WP_SUB:
+        case WP_MUL:
+        case WP_DIV:
+            return emit(node->type, 0, compile(node->l), compile(node->r));
+        case WP_NEG:
+            return emit(WP_NEG, 0, compile(node->l), -1);
+        case WP_F1:
+            return emit(WP_F1, ((struct wp_f1*)node)->ftype,
+                        compile(((struct wp_f1*)node)->l), -1);
+        case WP_F2:
+            return emit(WP_F2, ((struct wp_f2*)node)->ftype,
+                        compile(((struct wp_f2*)node)->l),
+                        compile(((struct wp_f2*)node)->r));
+        // Types generated by wp_ast_optimize: the value is stored in the
+        // node, and the symbols are still in the tree
+        case WP_ADD_VP:
+            return emit(WP_ADD, 0, constant(node->lvp.v), compile(node->r));
+        case WP_SUB_VP:
+            return emit(WP_SUB, 0, constant(node->lvp.v), compile(node->r));
+        case WP_MUL_VP:
+            return emit(WP_MUL, 0, constant(node->lvp.v), compile(node->r));
+        case WP_DIV_VP:
+            return emit(WP_DIV, 0, constant(node->lvp.v), compile(node->r));
+        case WP_ADD_PP:
+            return emit(WP_ADD, 0, compile(node->l), compile(node->r));
+        case WP_SUB_PP:
+            return emit(WP_SUB, 0, compile(node->l), compile(node->r));
+        case WP_MUL_PP:
+            return emit(WP_MUL, 0, compile(node->l), compile(node->r));
+        case WP_DIV_PP:
+            return emit(WP_DIV, 0, compile(node->l), compile(node->r));
+        case WP_NEG_P:
+            return emit(WP_NEG, 0, compile(node->l), -1);
+        default:
+            yyerror("ParserBytecode: unknown node type %d\n", node->type);
+            ok = false;
+            return constant(0.0);
+        }
+    }
+
+    std::vector<std::string> const& names;
+    std::vector<Value> values;
+    std::vector<Real> constants;
+    std::vector<int> constant_ids;
+    std::vector<Op> code;
+    std::map<std::tuple<int,int,int,int>,int> cse;
+    bool ok = true;
+};
+
+template <typename F>
+void
+apply1 (int n, Real* AMREX_RESTRICT d, Real const* AMREX_RESTRICT a, F const& f)
+{
+    AMREX_PRAGMA_SIMD
+    for (int i = 0; i < n; ++i) {
+        d[i] = f(a[i]);
+    }
+}
+
+template <typename F>
+void
+apply2 (int n, Real* AMREX_RESTRICT d, Real const* AMREX_RESTRICT a,
+        Real const* AMREX_RESTRICT b, F const& f)
+{
+    AMREX_PRAGMA_SIMD
+    for (int i = 0; i < n; ++i) {
+        d[i] = f(a[i], b[i]);
+    }
+}
+
+}
+
+bool
+ParserBytecode::compile (struct wp_node* ast, std::vector<std::string> const& names)
+{
+    clear();
+
+    Compiler c(names);
+    const int root = c.compile(ast);
+    if (not c.ok) return false;
+
+    m_nvars = names.size();
+    m_constants = c.constants;
+    const int nconstants = m_constants.size();
+    const int ncode = c.code.size();
+
+    // Last instruction using the result of each instruction
+    // (the result of the expression is never released)
+    std::vector<int> last_use(ncode, -1);
+    for (int i = 0; i < ncode; ++i) {
+        for (int arg : {c.code[i].a, c.code[i].b}) {
+            if (arg >= 0 and c.values[arg].kind == Compiler::Temporary) {
+                last_use[c.values[arg].index] = i;
+            }
+        }
+    }
+    if (c.values[root].kind == Compiler::Temporary) {
+        last_use[c.values[root].index] = ncode;
+    }
+
+    // Assign the registers. The destination of an instruction is never
+    // one of its arguments, so that the batch loops do not alias.
+    auto reg = [&] (int id) -> int {
+        const auto& v = c.values[id];
+        switch (v.kind) {
+        case Compiler::Variable: return v.index;
+        case Compiler::Constant: return m_nvars + v.index;
+        default:                 return m_code[v.index].d;
+        }
+    };
+    m_nregisters = m_nvars + nconstants;
+    std::vector<int> free_registers;
+    for (int i = 0; i < ncode; ++i)
+    {
+        const auto& op = c.code[i];
+        Instruction ins;
+        ins.op = op.op;
+        ins.f = op.f;
+        ins.a = reg(op.a);
+        ins.b = (op.b >= 0) ? reg(op.b) : -1;
+        if (free_registers.empty()) {
+            ins.d = m_nregisters++;
+        } else {
+            ins.d = free_registers.back();
+            free_registers.pop_back();
+        }
+        m_code.push_back(ins);
+
+        for (int arg : {op.a, (op.b != op.a) ? op.b : -1}) {
+            if (arg >= 0 and c.values[arg].kind == Compiler::Temporary and
+                last_use[c.values[arg].index] == i)
+            {
+                free_registers.push_back(m_code[c.values[arg].index].d);
+            }
+        }
+        if (last_use[i] < 0) free_registers.push_back(ins.d);
+    }
+    m_result = reg(root);
+
+    // The constants are loaded once: their registers are never overwritten
+    m_registers.assign(m_nregisters, 0.0);
+    std::copy(m_constants.begin(), m_constants.end(), m_registers.begin() + m_nvars);
+
+    m_ok = true;
+    return true;
+}
+
+void
+ParserBytecode::clear ()
+{
+    m_ok = false;
+    m_nvars = 0;
+    m_nregisters = 0;
+    m_result = 0;
+    m_code.clear();
+    m_constants.clear();
+    m_registers.clear();
+    m_workspace.clear();
+}
+
+void
+ParserBytecode::eval (int n, Real const* const* vars, Real* out) const
+{
+    const int nc = m_chunk_size;
+    if (m_workspace.size() != static_cast<std::size_t>(m_nregisters*nc)) {
+        m_workspace.resize(m_nregisters*nc);
+        for (int k = 0; k < m_constants.size(); ++k) {
+            std::fill_n(m_workspace.begin() + (m_nvars+k)*nc, nc, m_constants[k]);
+        }
+    }
+    Real* ws = m_workspace.data();
+
+    for (int i0 = 0; i0 < n; i0 += nc)
+    {
+        const int m = std::min(nc, n-i0);
+        // The variables are read in place
+        auto reg = [&] (int r) -> Real const* {
+            return (r < m_nvars) ? vars[r] + i0 : ws + r*nc;
+        };
+
+        for (auto const& ins : m_code)
+        {
+            Real* d = ws + ins.d*nc;
+            Real const* a = reg(ins.a);
+            Real const* b = (ins.b >= 0) ? reg(ins.b) : nullptr;
+            switch (ins.op)
+            {
+            case WP_ADD:
+                apply2(m, d, a, b, [] (Real x, Real y) { return x + y; });
+                break;
+            case WP_SUB:
+                apply2(m, d, a, b, [] (Real x, Real y) { return x - y; });
+                break;
+            case WP_MUL:
+                apply2(m, d, a, b, [] (Real x, Real y) { return x * y; });
+                break;
+            case WP_DIV:
+                apply2(m, d, a, b, [] (Real x, Real y) { return x / y; });
+                break;
+            case WP_NEG:
+                apply1(m, d, a, [] (Real x) { return -x; });
+                break;
+            case WP_F1:
+                switch (ins.f)
+                {
+                case WP_SQRT:   apply1(m, d, a, [] (Real x) { return std::sqrt(x); }); break;
+                case WP_EXP:    apply1(m, d, a, [] (Real x) { return std::exp(x); }); break;
+                case WP_LOG:    apply1(m, d, a, [] (Real x) { return std::log(x); }); break;
+                case WP_SIN:    apply1(m, d, a, [] (Real x) { return std::sin(x); }); break;
+                case WP_COS:    apply1(m, d, a, [] (Real x) { return std::cos(x); }); break;
+                case WP_ABS:    apply1(m, d, a, [] (Real x) { return std::abs(x); }); break;
+                case WP_POW_M3: apply1(m, d, a, [] (Real x) { return 1.0/(x*x*x); }); break;
+                case WP_POW_M2: apply1(m, d, a, [] (Real x) { return 1.0/(x*x); }); break;
+                case WP_POW_M1: apply1(m, d, a, [] (Real x) { return 1.0/x; }); break;
+                case WP_POW_P1: apply1(m, d, a, [] (Real x) { return x; }); break;
+                case WP_POW_P2: apply1(m, d, a, [] (Real x) { return x*x; }); break;
+                case WP_POW_P3: apply1(m, d, a, [] (Real x) { return x*x*x; }); break;
+                default:
+                {
+                    const auto f = static_cast<enum wp_f1_t>(ins.f);
+                    for (int i = 0; i < m; ++i) {
+                        d[i] = wp_call_f1(f, a[i]);
+                    }
+                }
+                }
+                break;
+            default: // WP_F2
+                switch (ins.f)
+                {
+                case WP_POW:
+                    apply2(m, d, a, b, [] (Real x, Real y) { return std::pow(x,y); });
+                    break;
+                case WP_GT:
+                    apply2(m, d, a, b, [] (Real x, Real y) { return (x > y) ? 1.0 : 0.0; });
+                    break;
+                case WP_LT:
+                    apply2(m, d, a, b, [] (Real x, Real y) { return (x < y) ? 1.0 : 0.0; });
+                    break;
+                case WP_MIN:
+                    apply2(m, d, a, b, [] (Real x, Real y) { return (x < y) ? x : y; });
+                    break;
+                case WP_MAX:
+                    apply2(m, d, a, b, [] (Real x, Real y) { return (x > y) ? x : y; });
+                    break;
+                default:
+                {
+                    const auto f = static_cast<enum wp_f2_t>(ins.f);
+                    for (int i = 0; i < m; ++i) {
+                        d[i] = wp_call_f2(f, a[i], b[i]);
+                    }
+                }
+                }
+            }
+        }
+
+        Real const* result = reg(m_result);
+        std::copy(result, result+m, out+i0);
+    }
+}
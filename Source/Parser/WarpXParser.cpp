@@ -1,5 +1,6 @@
 
 #include <algorithm>
+#include <AMReX_BLassert.H>
 #include "WarpXParser.H"
 
 WarpXParser::WarpXParser (std::string const& func_body)
@@ -22,6 +23,7 @@ WarpXParser::define (std::string const& func_body)
     int nthreads = omp_get_max_threads();
     m_variables.resize(nthreads);
     m_parser.resize(nthreads);
+    m_bytecode.resize(nthreads);
     m_parser[0] = wp_c_parser_new(f.c_str());
 #pragma omp parallel
     {
@@ -59,13 +61,17 @@ WarpXParser::clear ()
     }
     m_parser.clear();
     m_variables.clear();
+    m_bytecode.clear();
 
 #else
 
     if (m_parser) wp_parser_delete(m_parser);
     m_parser = nullptr;
+    m_bytecode.clear();
 
 #endif
+
+    m_names.clear();
 }
 
 void
@@ -82,6 +88,8 @@ WarpXParser::registerVariable (std::string const& name, amrex::Real& var)
 void
 WarpXParser::registerVariables (std::vector<std::string> const& names)
 {
+    m_names = names;
+
 #ifdef _OPENMP
 
 // This must be called outside OpenMP parallel region.
@@ -93,6 +101,7 @@ WarpXParser::registerVariables (std::vector<std::string> const& names)
         for (int j = 0; j < names.size(); ++j) {
             wp_parser_regvar(p, names[j].c_str(), &(v[j]));
         }
+        compile();
     }
 
 #else
@@ -100,6 +109,7 @@ WarpXParser::registerVariables (std::vector<std::string> const& names)
     for (int j = 0; j < names.size(); ++j) {
         wp_parser_regvar(m_parser, names[j].c_str(), &(m_variables[j]));
     }
+    compile();
 
 #endif
 }
@@ -114,13 +124,49 @@ WarpXParser::setConstant (std::string const& name, amrex::Real c)
 #pragma omp parallel if (!in_parallel)
     {
         wp_parser_setconst(m_parser[omp_get_thread_num()], name.c_str(), c);
+        compile();
     }
 
 #else
 
     wp_parser_setconst(m_parser, name.c_str(), c);
+    compile();
+
+#endif
+}
+
+void
+WarpXParser::compile ()
+{
+    // The variables must be known to compile the bytecode
+    if (m_names.empty()) return;
+#ifdef _OPENMP
+    const int tid = omp_get_thread_num();
+    m_bytecode[tid].compile(m_parser[tid]->ast, m_names);
+#else
+    m_bytecode.compile(m_parser->ast, m_names);
+#endif
+}
 
+void
+WarpXParser::evalBatch (int n, amrex::Real const* x, amrex::Real const* y,
+                        amrex::Real const* z, amrex::Real* out) const
+{
+#ifdef _OPENMP
+    ParserBytecode const& bytecode = m_bytecode[omp_get_thread_num()];
+#else
+    ParserBytecode const& bytecode = m_bytecode;
 #endif
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_names.size() <= 3,
+        "WarpXParser::evalBatch: at most three variables can be registered");
+    if (bytecode.ok()) {
+        amrex::Real const* vars[3] = {x, y, z};
+        bytecode.eval(n, vars, out);
+    } else {
+        for (int i = 0; i < n; ++i) {
+            out[i] = eval(x[i], y[i], z[i]);
+        }
+    }
 }
 
 void
@@ -258,9 +258,40 @@ MultiParticleContainer::Evolve (int lev,
     if (cjz) cjz->setVal(0.0);
     if (rho) rho->setVal(0.0);
     if (crho) crho->setVal(0.0);
-    for (auto& pc : allcontainers) {
-        pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
-                   rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type);
+    for (unsigned i = 0, n = allcontainers.size(); i < n; ++i) {
+        Real wt = amrex::second();
+        allcontainers[i]->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
+                                 rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type);
+        if (m_measure_evolve_time) {
+            Gpu::synchronize();
+            m_evolve_time[i] += amrex::second() - wt;
+        }
+    }
+}
+
+void
+MultiParticleContainer::StartEvolveTimers ()
+{
+    m_evolve_time.assign(allcontainers.size(), 0.);
+    m_measure_evolve_time = true;
+}
+
+Vector<Real>
+MultiParticleContainer::StopEvolveTimers ()
+{
+    m_measure_evolve_time = false;
+    return m_evolve_time;
+}
+
+void
+MultiParticleContainer::AddParticleCosts (int lev, LayoutData<Real>& costs,
+                                          const Vector<Real>& particles_wt) const
+{
+    for (unsigned i = 0, n = allcontainers.size(); i < n; ++i) {
+        // The particle tiles are indexed by (grid index, tile index)
+        for (const auto& kv : allcontainers[i]->GetParticles(lev)) {
+            costs[kv.first.first] += particles_wt[i] * kv.second.numParticles();
+        }
     }
 }
 
@@ -305,6 +336,14 @@ MultiParticleContainer::SortParticlesByCell ()
     }
 }
 
+void
+MultiParticleContainer::SortParticlesByCellIncremental ()
+{
+    for (auto& pc : allcontainers) {
+        pc->SortParticlesByCellIncremental();
+    }
+}
+
 void
 MultiParticleContainer::Redistribute ()
 {
@@ -369,6 +408,36 @@ MultiParticleContainer::PostRestart ()
     pc_tmp->PostRestart();
 }
 
+namespace
+{
+    /* \brief Append the particle data from all grids and tiles in
+     *  diagnostic_particles to part. part contains particles from all
+     *  AMR levels indistinctly.
+     */
+    void AppendDiagnosticParticles (
+        const WarpXParticleContainer::DiagnosticParticles& diagnostic_particles,
+        WarpXParticleContainer::DiagnosticParticleData& part)
+    {
+        // Here, diagnostic_particles[lev][index] is a WarpXParticleContainer::DiagnosticParticleData
+        // where "lev" is the AMR level and "index" is a [grid index][tile index] pair.
+
+        // Loop over AMR levels
+        for (int lev = 0; lev < static_cast<int>(diagnostic_particles.size()); ++lev){
+            // Loop over [grid index][tile index] pairs
+            for (auto it = diagnostic_particles[lev].begin(); it != diagnostic_particles[lev].end(); ++it){
+                // it->first is the [grid index][tile index] key
+                // it->second is the corresponding
+                // WarpXParticleContainer::DiagnosticParticleData value
+                for (int comp = 0; comp < DiagIdx::nattribs; ++comp){
+                    part.GetRealData(comp).insert(  part.GetRealData(comp).end(),
+                                                    it->second.GetRealData(comp).begin(),
+                                                    it->second.GetRealData(comp).end());
+                }
+            }
+        }
+    }
+}
+
 void
 MultiParticleContainer
 ::GetLabFrameData(const std::string& snapshot_name,
@@ -386,47 +455,37 @@ MultiParticleContainer
         WarpXParticleContainer* pc = allcontainers[isp].get();
         WarpXParticleContainer::DiagnosticParticles diagnostic_particles;
         pc->GetParticleSlice(direction, z_old, z_new, t_boost, t_lab, dt, diagnostic_particles);
-        // Here, diagnostic_particles[lev][index] is a WarpXParticleContainer::DiagnosticParticleData
-        // where "lev" is the AMR level and "index" is a [grid index][tile index] pair.
-
-        // Loop over AMR levels
-        for (int lev = 0; lev <= pc->finestLevel(); ++lev){
-            // Loop over [grid index][tile index] pairs
-            // and Fills parts[species number i] with particle data from all grids and
-            // tiles in diagnostic_particles. parts contains particles from all
-            // AMR levels indistinctly.
-            for (auto it = diagnostic_particles[lev].begin(); it != diagnostic_particles[lev].end(); ++it){
-                // it->first is the [grid index][tile index] key
-                // it->second is the corresponding
-                // WarpXParticleContainer::DiagnosticParticleData value
-                parts[i].GetRealData(DiagIdx::w).insert(  parts[i].GetRealData(DiagIdx::w  ).end(),
-                                                          it->second.GetRealData(DiagIdx::w  ).begin(),
-                                                          it->second.GetRealData(DiagIdx::w  ).end());
-
-                parts[i].GetRealData(DiagIdx::x).insert(  parts[i].GetRealData(DiagIdx::x  ).end(),
-                                                          it->second.GetRealData(DiagIdx::x  ).begin(),
-                                                          it->second.GetRealData(DiagIdx::x  ).end());
-
-                parts[i].GetRealData(DiagIdx::y).insert(  parts[i].GetRealData(DiagIdx::y  ).end(),
-                                                          it->second.GetRealData(DiagIdx::y  ).begin(),
-                                                          it->second.GetRealData(DiagIdx::y  ).end());
-
-                parts[i].GetRealData(DiagIdx::z).insert(  parts[i].GetRealData(DiagIdx::z  ).end(),
-                                                          it->second.GetRealData(DiagIdx::z  ).begin(),
-                                                          it->second.GetRealData(DiagIdx::z  ).end());
+        // Fills parts[species number i] with particle data from all grids and
+        // tiles in diagnostic_particles.
+        AppendDiagnosticParticles(diagnostic_particles, parts[i]);
+    }
+}
 
-                parts[i].GetRealData(DiagIdx::ux).insert(  parts[i].GetRealData(DiagIdx::ux).end(),
-                                                           it->second.GetRealData(DiagIdx::ux).begin(),
-                                                           it->second.GetRealData(DiagIdx::ux).end());
+/* \brief Same as GetLabFrameData, for several snapshots at once.
+ * Each species is swept once for all the snapshots (see GetParticleSlices).
+ * \param z_old, z_new, t_lab: position and time of each snapshot
+ * \param parts: parts[k] is the particle buffer of snapshot k, with one
+ *  element per species dumped to the back-transformed diagnostics.
+ */
+void
+MultiParticleContainer
+::GetLabFrameDataMulti(const int direction,
+                       const Vector<Real>& z_old, const Vector<Real>& z_new,
+                       const Real t_boost, const Vector<Real>& t_lab, const Real dt,
+                       Vector<Vector<WarpXParticleContainer::DiagnosticParticleData>*>& parts) const
+{
 
-                parts[i].GetRealData(DiagIdx::uy).insert(  parts[i].GetRealData(DiagIdx::uy).end(),
-                                                           it->second.GetRealData(DiagIdx::uy).begin(),
-                                                           it->second.GetRealData(DiagIdx::uy).end());
+    BL_PROFILE("MultiParticleContainer::GetLabFrameDataMulti");
 
-                parts[i].GetRealData(DiagIdx::uz).insert(  parts[i].GetRealData(DiagIdx::uz).end(),
-                                                           it->second.GetRealData(DiagIdx::uz).begin(),
-                                                           it->second.GetRealData(DiagIdx::uz).end());
-            }
+    // Loop over particle species
+    for (int i = 0; i < nspecies_boosted_frame_diags; ++i){
+        int isp = map_species_boosted_frame_diags[i];
+        WarpXParticleContainer* pc = allcontainers[isp].get();
+        Vector<WarpXParticleContainer::DiagnosticParticles> diagnostic_particles;
+        pc->GetParticleSlices(direction, z_old, z_new, t_boost, t_lab, dt, diagnostic_particles);
+        // Loop over snapshots
+        for (int k = 0; k < static_cast<int>(parts.size()); ++k){
+            AppendDiagnosticParticles(diagnostic_particles[k], (*parts[k])[i]);
         }
     }
 }
@@ -608,6 +667,28 @@ namespace
             runtime_attribs_product[4] = soa_product.GetRealData(comps_product["uyold"]).data() + np_product_old;
             runtime_attribs_product[5] = soa_product.GetRealData(comps_product["uzold"]).data() + np_product_old;
         }
+        // --- product fields on particles, if stored as runtime attribs (see
+        // StoreFieldsOnParticles): copied from the source particle if the
+        // source species stores them too, set to 0 otherwise
+        GpuArray<ParticleReal*,FieldIdx::nfields> fields_source;
+        GpuArray<ParticleReal*,FieldIdx::nfields> fields_product;
+        const bool do_fields_product = pc_product->FieldsAreStoredOnParticles();
+        const bool do_fields_source = do_fields_product
+            && pc_source->FieldsAreStoredOnParticles();
+        if (do_fields_product) {
+            std::map<std::string, int> comps_product = pc_product->getParticleComps();
+            for (int i = 0; i < FieldIdx::nfields; ++i) {
+                fields_product[i] = soa_product.GetRealData(
+                    comps_product[ParticleStringNames::field_names[i]]).data() + np_product_old;
+            }
+        }
+        if (do_fields_source) {
+            std::map<std::string, int> comps_source = pc_source->getParticleComps();
+            for (int i = 0; i < FieldIdx::nfields; ++i) {
+                fields_source[i] = soa_source.GetRealData(
+                    comps_source[ParticleStringNames::field_names[i]]).data();
+            }
+        }
 
         int pid_product;
 #pragma omp critical (doFieldIonization_nextid)
@@ -654,6 +735,11 @@ namespace
                         runtime_attribs_product[4][ip] = runtime_uold_source[1][ip];
                         runtime_attribs_product[5][ip] = runtime_uold_source[2][ip];
                     }
+                    if (do_fields_product) {
+                        for (int i = 0; i < FieldIdx::nfields; ++i) {
+                            fields_product[i][ip] = do_fields_source ? fields_source[i][is] : 0.;
+                        }
+                    }
                 }
             }
         );
@@ -21,7 +21,10 @@ using namespace amrex;
 PhotonParticleContainer::PhotonParticleContainer (AmrCore* amr_core, int ispecies,
                                                   const std::string& name)
     : PhysicalParticleContainer(amr_core, ispecies, name)
-{}
+{
+    // Photons are pushed by PhotonParticleContainer::PushPX
+    m_can_fuse_gather_push_deposit = false;
+}
 
 void PhotonParticleContainer::InitData()
 {
@@ -37,6 +40,8 @@ PhotonParticleContainer::PushPX(WarpXParIter& pti,
                                 Cuda::ManagedDeviceVector<ParticleReal>& xp,
                                 Cuda::ManagedDeviceVector<ParticleReal>& yp,
                                 Cuda::ManagedDeviceVector<ParticleReal>& zp,
+                                RealVector& Exp, RealVector& Eyp, RealVector& Ezp,
+                                RealVector& Bxp, RealVector& Byp, RealVector& Bzp,
                                 Real dt, DtType a_dt_type)
 {
 
@@ -49,12 +54,6 @@ PhotonParticleContainer::PushPX(WarpXParIter& pti,
     ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr();
     ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
     ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Ex = attribs[PIdx::Ex].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Ey = attribs[PIdx::Ey].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Ez = attribs[PIdx::Ez].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Bx = attribs[PIdx::Bx].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT By = attribs[PIdx::By].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Bz = attribs[PIdx::Bz].dataPtr();
 
     if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags)
     {
@@ -1,4 +1,6 @@
 #include <limits>
+#include <algorithm>
+#include <numeric>
 #include <sstream>
 
 #include <MultiParticleContainer.H>
@@ -15,6 +17,7 @@
 #include <UpdatePosition.H>
 #include <UpdateMomentumBoris.H>
 #include <UpdateMomentumVay.H>
+#include <FusedGatherPushDeposit.H>
 
 using namespace amrex;
 
@@ -52,30 +55,52 @@ PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int isp
     pp.query("plot_species", plot_species);
     int do_user_plot_vars;
     do_user_plot_vars = pp.queryarr("plot_vars", plot_vars);
+
+    // The fields gathered on the particles are only kept after the push
+    // (as runtime components) when they are used afterwards: by the
+    // ionization module, or when they are requested in plot_vars.
+    bool plot_fields = false;
+    if (do_user_plot_vars){
+        for (const auto& var : plot_vars){
+            for (const auto& field_name : ParticleStringNames::field_names){
+                if (var == field_name) plot_fields = true;
+            }
+        }
+    }
+#ifdef AMREX_USE_GPU
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        plot_fields == false,
+        "Plotting the fields on particles does not work on GPU so far, because "
+        "the current version of Redistribute in AMReX does not work with runtime parameters");
+#endif
+    if (do_field_ionization || plot_fields){
+        StoreFieldsOnParticles();
+    }
+
     if (not do_user_plot_vars){
         // By default, all particle variables are dumped to plotfiles,
         // including {x,y,z,ux,uy,uz}old variables when running in a
         // boosted frame
         if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags){
-            plot_flags.resize(PIdx::nattribs + 6, 1);
+            plot_flags.resize(NumRealComps() + 6, 1);
         } else {
-            plot_flags.resize(PIdx::nattribs, 1);
+            plot_flags.resize(NumRealComps(), 1);
         }
     } else {
         // Set plot_flag to 0 for all attribs
         if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags){
-            plot_flags.resize(PIdx::nattribs + 6, 0);
+            plot_flags.resize(NumRealComps() + 6, 0);
         } else {
-            plot_flags.resize(PIdx::nattribs, 0);
+            plot_flags.resize(NumRealComps(), 0);
         }
         // If not none, set plot_flags values to 1 for elements in plot_vars.
         if (plot_vars[0] != "none"){
             for (const auto& var : plot_vars){
-                // Return error if var not in PIdx.
+                // Return error if var is not a particle component.
                 AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
-                    ParticleStringNames::to_index.count(var),
+                    particle_comps.count(var),
                     "plot_vars argument not in ParticleStringNames");
-                plot_flags[ParticleStringNames::to_index.at(var)] = 1;
+                plot_flags[particle_comps.at(var)] = 1;
             }
         }
     }
@@ -306,7 +331,7 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
     }
 #endif
 
-    MultiFab* cost = WarpX::getCosts(lev);
+    LayoutData<Real>* cost = WarpX::getCosts(lev);
 
     const int nlevs = numLevels();
     static bool refine_injection = false;
@@ -631,14 +656,14 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
 #endif
         }, shared_mem_bytes);
 
-        if (cost) {
-            wt = (amrex::second() - wt) / tile_box.d_numPts();
-            Array4<Real> const& costarr = cost->array(mfi);
-            amrex::ParallelFor(tile_box,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                costarr(i,j,k) += wt;
-            });
+        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        {
+            Gpu::synchronize();
+            wt = amrex::second() - wt;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            (*cost)[mfi.index()] += wt;
         }
     }
 
@@ -674,11 +699,10 @@ FieldGatherES (const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,
             const auto& particles = pti.GetArrayOfStructs();
             int nstride = particles.dataShape().first;
             const long np  = pti.numParticles();
-            auto& attribs = pti.GetAttribs();
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
+            auto& Exp = GetFieldOnParticles(pti, FieldIdx::Ex, 0);
+            auto& Eyp = GetFieldOnParticles(pti, FieldIdx::Ey, 0);
 #if AMREX_SPACEDIM == 3
-            auto& Ezp = attribs[PIdx::Ez];
+            auto& Ezp = GetFieldOnParticles(pti, FieldIdx::Ez, 0);
 #endif
             Exp.assign(np,0.0);
             Eyp.assign(np,0.0);
@@ -743,11 +767,10 @@ FieldGatherES (const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,
             int nstride = particles.dataShape().first;
             const long np  = pti.numParticles();
 
-            auto& attribs = pti.GetAttribs();
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
+            auto& Exp = GetFieldOnParticles(pti, FieldIdx::Ex, 0);
+            auto& Eyp = GetFieldOnParticles(pti, FieldIdx::Ey, 0);
 #if AMREX_SPACEDIM == 3
-            auto& Ezp = attribs[PIdx::Ez];
+            auto& Ezp = GetFieldOnParticles(pti, FieldIdx::Ez, 0);
 #endif
             Exp.assign(np,0.0);
             Eyp.assign(np,0.0);
@@ -831,11 +854,11 @@ PhysicalParticleContainer::EvolveES (const Vector<std::array<std::unique_ptr<Mul
             auto& uzp = attribs[PIdx::uz];
 #endif
 
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
+            auto& Exp = GetFieldOnParticles(pti, FieldIdx::Ex, 0);
+            auto& Eyp = GetFieldOnParticles(pti, FieldIdx::Ey, 0);
 
 #if AMREX_SPACEDIM == 3
-            auto& Ezp = attribs[PIdx::Ez];
+            auto& Ezp = GetFieldOnParticles(pti, FieldIdx::Ez, 0);
 #endif
             //
             // Particle Push
@@ -865,7 +888,7 @@ PhysicalParticleContainer::FieldGather (int lev,
 
     BL_ASSERT(OnSameGrids(lev,Ex));
 
-    MultiFab* cost = WarpX::getCosts(lev);
+    LayoutData<Real>* cost = WarpX::getCosts(lev);
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -882,14 +905,12 @@ PhysicalParticleContainer::FieldGather (int lev,
 
             const Box& box = pti.validbox();
 
-            auto& attribs = pti.GetAttribs();
-
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+            auto& Exp = GetFieldOnParticles(pti, FieldIdx::Ex, thread_num);
+            auto& Eyp = GetFieldOnParticles(pti, FieldIdx::Ey, thread_num);
+            auto& Ezp = GetFieldOnParticles(pti, FieldIdx::Ez, thread_num);
+            auto& Bxp = GetFieldOnParticles(pti, FieldIdx::Bx, thread_num);
+            auto& Byp = GetFieldOnParticles(pti, FieldIdx::By, thread_num);
+            auto& Bzp = GetFieldOnParticles(pti, FieldIdx::Bz, thread_num);
 
             const long np = pti.numParticles();
 
@@ -922,15 +943,14 @@ PhysicalParticleContainer::FieldGather (int lev,
                         Ex.nGrow(), e_is_nodal,
                         0, np, thread_num, lev, lev);
 
-            if (cost) {
-                const Box& tbx = pti.tilebox();
-                wt = (amrex::second() - wt) / tbx.d_numPts();
-                Array4<Real> const& costarr = cost->array(pti);
-                amrex::ParallelFor(tbx,
-                                   [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                                   {
-                                       costarr(i,j,k) += wt;
-                                   });
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                Gpu::synchronize();
+                wt = amrex::second() - wt;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+                (*cost)[pti.index()] += wt;
             }
         }
     }
@@ -951,6 +971,7 @@ PhysicalParticleContainer::Evolve (int lev,
     BL_PROFILE_VAR_NS("PPC::Evolve::Copy", blp_copy);
     BL_PROFILE_VAR_NS("PPC::FieldGather", blp_fg);
     BL_PROFILE_VAR_NS("PPC::ParticlePush", blp_ppc_pp);
+    BL_PROFILE_VAR_NS("PPC::FusedGatherPushDeposit", blp_fused);
 
     const std::array<Real,3>& dx = WarpX::CellSize(lev);
     const std::array<Real,3>& cdx = WarpX::CellSize(std::max(lev-1,0));
@@ -961,12 +982,25 @@ PhysicalParticleContainer::Evolve (int lev,
 
     BL_ASSERT(OnSameGrids(lev,jx));
 
-    MultiFab* cost = WarpX::getCosts(lev);
+    LayoutData<Real>* cost = WarpX::getCosts(lev);
     const iMultiFab* current_masks = WarpX::CurrentBufferMasks(lev);
     const iMultiFab* gather_masks = WarpX::GatherBufferMasks(lev);
 
     bool has_buffer = cEx || cjx;
 
+    // Gather, push and deposit in a single pass over the particles when
+    // possible. Particles in mesh-refinement buffers need separate gather
+    // and deposition passes, so the fused kernel is not used with buffers.
+    const bool fuse_gather_push_deposit = do_fused_gather_push_deposit &&
+        m_can_fuse_gather_push_deposit && !has_buffer;
+
+    // With tile coloring, the tiles are processed in num_tile_colors passes.
+    // Tiles processed in the same pass never deposit current in the same
+    // cells, so they deposit directly in jx, jy, jz, without per-thread
+    // buffers and atomic accumulation.
+    const bool color_tiles = UseTileColoring(jx);
+    const int ncolors = color_tiles ? num_tile_colors : 1;
+
     if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags)
     {
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
@@ -975,11 +1009,20 @@ PhysicalParticleContainer::Evolve (int lev,
             const auto lev = pti.GetLevel();
             const auto index = pti.GetPairIndex();
             tmp_particle_data.resize(finestLevel()+1);
-            for (int i = 0; i < TmpIdx::nattribs; ++i)
-                tmp_particle_data[lev][index][i].resize(np);
+            if (m_bfd_sparse) {
+                // Only create the map entries: the arrays are
+                // resized in copy_attribs
+                tmp_particle_data[lev][index];
+                tmp_particle_index.resize(finestLevel()+1);
+                tmp_particle_index[lev][index];
+            } else {
+                for (int i = 0; i < TmpIdx::nattribs; ++i)
+                    tmp_particle_data[lev][index][i].resize(np);
+            }
         }
     }
 
+    for (int color = 0; color < ncolors; ++color)
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -995,6 +1038,8 @@ PhysicalParticleContainer::Evolve (int lev,
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
+            if (color_tiles && TileColor(pti) != color) continue;
+
             Real wt = amrex::second();
 
             const Box& box = pti.validbox();
@@ -1005,12 +1050,12 @@ PhysicalParticleContainer::Evolve (int lev,
             auto& uxp = attribs[PIdx::ux];
             auto& uyp = attribs[PIdx::uy];
             auto& uzp = attribs[PIdx::uz];
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+            auto& Exp = GetFieldOnParticles(pti, FieldIdx::Ex, thread_num);
+            auto& Eyp = GetFieldOnParticles(pti, FieldIdx::Ey, thread_num);
+            auto& Ezp = GetFieldOnParticles(pti, FieldIdx::Ez, thread_num);
+            auto& Bxp = GetFieldOnParticles(pti, FieldIdx::Bx, thread_num);
+            auto& Byp = GetFieldOnParticles(pti, FieldIdx::By, thread_num);
+            auto& Bzp = GetFieldOnParticles(pti, FieldIdx::Bz, thread_num);
 
             const long np = pti.numParticles();
 
@@ -1037,12 +1082,14 @@ PhysicalParticleContainer::Evolve (int lev,
                                exfab, eyfab, ezfab, bxfab, byfab, bzfab);
             }
 
-            Exp.assign(np,0.0);
-            Eyp.assign(np,0.0);
-            Ezp.assign(np,0.0);
-            Bxp.assign(np,WarpX::B_external[0]);
-            Byp.assign(np,WarpX::B_external[1]);
-            Bzp.assign(np,WarpX::B_external[2]);
+            if (! fuse_gather_push_deposit) {
+                Exp.assign(np,0.0);
+                Eyp.assign(np,0.0);
+                Ezp.assign(np,0.0);
+                Bxp.assign(np,WarpX::B_external[0]);
+                Byp.assign(np,WarpX::B_external[1]);
+                Bzp.assign(np,WarpX::B_external[2]);
+            }
 
             // Determine which particles deposit/gather in the buffer, and
             // which particles deposit/gather in the fine patch
@@ -1092,84 +1139,109 @@ PhysicalParticleContainer::Evolve (int lev,
 
                 int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
 
-                //
-                // Field Gather of Aux Data (i.e., the full solution)
-                //
-                BL_PROFILE_VAR_START(blp_fg);
-                FieldGather(pti, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                            exfab, eyfab, ezfab, bxfab, byfab, bzfab,
-                            Ex.nGrow(), e_is_nodal,
-                            0, np_gather, thread_num, lev, lev);
-
-                if (np_gather < np)
+                if (fuse_gather_push_deposit)
                 {
-                    const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
-                    const Box& cbox = amrex::coarsen(box,ref_ratio);
-
-                    // Data on the grid
-                    FArrayBox const* cexfab = &(*cEx)[pti];
-                    FArrayBox const* ceyfab = &(*cEy)[pti];
-                    FArrayBox const* cezfab = &(*cEz)[pti];
-                    FArrayBox const* cbxfab = &(*cBx)[pti];
-                    FArrayBox const* cbyfab = &(*cBy)[pti];
-                    FArrayBox const* cbzfab = &(*cBz)[pti];
-
-                    if (WarpX::use_fdtd_nci_corr)
-                    {
-                        // Filter arrays (*cEx)[pti], store the result in
-                        // filtered_Ex and update pointer cexfab so that it
-                        // points to filtered_Ex (and do the same for all
-                        // components of E and B)
-                        applyNCIFilter(lev-1, cbox, exeli, eyeli, ezeli, bxeli, byeli, bzeli,
-                                       filtered_Ex, filtered_Ey, filtered_Ez,
-                                       filtered_Bx, filtered_By, filtered_Bz,
-                                       (*cEx)[pti], (*cEy)[pti], (*cEz)[pti],
-                                       (*cBx)[pti], (*cBy)[pti], (*cBz)[pti],
-                                       cexfab, ceyfab, cezfab, cbxfab, cbyfab, cbzfab);
+                    //
+                    // Field gather, particle push and current deposition
+                    // in a single pass over the particles
+                    //
+                    int* AMREX_RESTRICT ion_lev;
+                    if (do_field_ionization){
+                        ion_lev = pti.GetiAttribs(particle_icomps["ionization_level"]).dataPtr();
+                    } else {
+                        ion_lev = nullptr;
                     }
 
-                    // Field gather for particles in gather buffers
-                    e_is_nodal = cEx->is_nodal() and cEy->is_nodal() and cEz->is_nodal();
-                    FieldGather(pti, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                                cexfab, ceyfab, cezfab,
-                                cbxfab, cbyfab, cbzfab,
-                                cEx->nGrow(), e_is_nodal,
-                                nfine_gather, np-nfine_gather,
-                                thread_num, lev, lev-1);
+                    BL_PROFILE_VAR_START(blp_fused);
+                    FusedGatherPushDeposit(pti, wp, uxp, uyp, uzp,
+                                           Exp, Eyp, Ezp, Bxp, Byp, Bzp, ion_lev,
+                                           exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                           Ex.nGrow(), e_is_nodal, &jx, &jy, &jz,
+                                           thread_num, lev, dt, a_dt_type, color_tiles);
+                    BL_PROFILE_VAR_STOP(blp_fused);
                 }
+                else
+                {
+                    //
+                    // Field Gather of Aux Data (i.e., the full solution)
+                    //
+                    BL_PROFILE_VAR_START(blp_fg);
+                    FieldGather(pti, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                                exfab, eyfab, ezfab, bxfab, byfab, bzfab,
+                                Ex.nGrow(), e_is_nodal,
+                                0, np_gather, thread_num, lev, lev);
 
-                BL_PROFILE_VAR_STOP(blp_fg);
+                    if (np_gather < np)
+                    {
+                        const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
+                        const Box& cbox = amrex::coarsen(box,ref_ratio);
+
+                        // Data on the grid
+                        FArrayBox const* cexfab = &(*cEx)[pti];
+                        FArrayBox const* ceyfab = &(*cEy)[pti];
+                        FArrayBox const* cezfab = &(*cEz)[pti];
+                        FArrayBox const* cbxfab = &(*cBx)[pti];
+                        FArrayBox const* cbyfab = &(*cBy)[pti];
+                        FArrayBox const* cbzfab = &(*cBz)[pti];
+
+                        if (WarpX::use_fdtd_nci_corr)
+                        {
+                            // Filter arrays (*cEx)[pti], store the result in
+                            // filtered_Ex and update pointer cexfab so that it
+                            // points to filtered_Ex (and do the same for all
+                            // components of E and B)
+                            applyNCIFilter(lev-1, cbox, exeli, eyeli, ezeli, bxeli, byeli, bzeli,
+                                           filtered_Ex, filtered_Ey, filtered_Ez,
+                                           filtered_Bx, filtered_By, filtered_Bz,
+                                           (*cEx)[pti], (*cEy)[pti], (*cEz)[pti],
+                                           (*cBx)[pti], (*cBy)[pti], (*cBz)[pti],
+                                           cexfab, ceyfab, cezfab, cbxfab, cbyfab, cbzfab);
+                        }
 
-                //
-                // Particle Push
-                //
-                BL_PROFILE_VAR_START(blp_ppc_pp);
-                PushPX(pti, m_xp[thread_num], m_yp[thread_num], m_zp[thread_num], dt, a_dt_type);
-                BL_PROFILE_VAR_STOP(blp_ppc_pp);
+                        // Field gather for particles in gather buffers
+                        e_is_nodal = cEx->is_nodal() and cEy->is_nodal() and cEz->is_nodal();
+                        FieldGather(pti, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                                    cexfab, ceyfab, cezfab,
+                                    cbxfab, cbyfab, cbzfab,
+                                    cEx->nGrow(), e_is_nodal,
+                                    nfine_gather, np-nfine_gather,
+                                    thread_num, lev, lev-1);
+                    }
 
-                //
-                // Current Deposition
-                //
+                    BL_PROFILE_VAR_STOP(blp_fg);
+
+                    //
+                    // Particle Push
+                    //
+                    BL_PROFILE_VAR_START(blp_ppc_pp);
+                    PushPX(pti, m_xp[thread_num], m_yp[thread_num], m_zp[thread_num],
+                           Exp, Eyp, Ezp, Bxp, Byp, Bzp, dt, a_dt_type);
+                    BL_PROFILE_VAR_STOP(blp_ppc_pp);
+
+                    //
+                    // Current Deposition
+                    //
+
+                    int* AMREX_RESTRICT ion_lev;
+                    if (do_field_ionization){
+                        ion_lev = pti.GetiAttribs(particle_icomps["ionization_level"]).dataPtr();
+                    } else {
+                        ion_lev = nullptr;
+                    }
 
-                int* AMREX_RESTRICT ion_lev;
-                if (do_field_ionization){
-                    ion_lev = pti.GetiAttribs(particle_icomps["ionization_level"]).dataPtr();
-                } else {
-                    ion_lev = nullptr;
-                }
+                    // Deposit inside domains
+                    DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, &jx, &jy, &jz,
+                                   0, np_current, thread_num,
+                                   lev, lev, dt, color_tiles);
+                    if (has_buffer){
+                        // Deposit in buffers
+                        DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, cjx, cjy, cjz,
+                                       np_current, np-np_current, thread_num,
+                                       lev, lev-1, dt);
+                    }
 
-                // Deposit inside domains
-                DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, &jx, &jy, &jz,
-                               0, np_current, thread_num,
-                               lev, lev, dt);
-                if (has_buffer){
-                    // Deposit in buffers
-                    DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, cjx, cjy, cjz,
-                                   np_current, np-np_current, thread_num,
-                                   lev, lev-1, dt);
                 }
 
-
                 //
                 // copy particle data back
                 //
@@ -1194,15 +1266,14 @@ PhysicalParticleContainer::Evolve (int lev,
                 }
             }
 
-            if (cost) {
-                const Box& tbx = pti.tilebox();
-                wt = (amrex::second() - wt) / tbx.d_numPts();
-                Array4<Real> const& costarr = cost->array(pti);
-                amrex::ParallelFor(tbx,
-                                   [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                                   {
-                                       costarr(i,j,k) += wt;
-                                   });
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                Gpu::synchronize();
+                wt = amrex::second() - wt;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+                (*cost)[pti.index()] += wt;
             }
         }
     }
@@ -1454,6 +1525,8 @@ PhysicalParticleContainer::PushPX(WarpXParIter& pti,
                                   Cuda::ManagedDeviceVector<ParticleReal>& xp,
                                   Cuda::ManagedDeviceVector<ParticleReal>& yp,
                                   Cuda::ManagedDeviceVector<ParticleReal>& zp,
+                                  RealVector& Exp, RealVector& Eyp, RealVector& Ezp,
+                                  RealVector& Bxp, RealVector& Byp, RealVector& Bzp,
                                   Real dt, DtType a_dt_type)
 {
 
@@ -1466,12 +1539,12 @@ PhysicalParticleContainer::PushPX(WarpXParIter& pti,
     ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr();
     ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
     ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Ex = attribs[PIdx::Ex].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Ey = attribs[PIdx::Ey].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Ez = attribs[PIdx::Ez].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Bx = attribs[PIdx::Bx].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT By = attribs[PIdx::By].dataPtr();
-    const ParticleReal* const AMREX_RESTRICT Bz = attribs[PIdx::Bz].dataPtr();
+    const ParticleReal* const AMREX_RESTRICT Ex = Exp.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT Ey = Eyp.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT Ez = Ezp.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT Bx = Bxp.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT By = Byp.dataPtr();
+    const ParticleReal* const AMREX_RESTRICT Bz = Bzp.dataPtr();
 
     if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags && (a_dt_type!=DtType::SecondHalf))
     {
@@ -1543,12 +1616,12 @@ PhysicalParticleContainer::PushP (int lev, Real dt,
 
             auto& attribs = pti.GetAttribs();
 
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+            auto& Exp = GetFieldOnParticles(pti, FieldIdx::Ex, thread_num);
+            auto& Eyp = GetFieldOnParticles(pti, FieldIdx::Ey, thread_num);
+            auto& Ezp = GetFieldOnParticles(pti, FieldIdx::Ez, thread_num);
+            auto& Bxp = GetFieldOnParticles(pti, FieldIdx::Bx, thread_num);
+            auto& Byp = GetFieldOnParticles(pti, FieldIdx::By, thread_num);
+            auto& Bzp = GetFieldOnParticles(pti, FieldIdx::Bz, thread_num);
 
             const long np = pti.numParticles();
 
@@ -1625,6 +1698,12 @@ void PhysicalParticleContainer::copy_attribs(WarpXParIter& pti,const ParticleRea
     const auto np = pti.numParticles();
     const auto lev = pti.GetLevel();
     const auto index = pti.GetPairIndex();
+
+    if (m_bfd_sparse) {
+        copy_attribs_sparse(pti, xp, yp, zp);
+        return;
+    }
+
     ParticleReal* AMREX_RESTRICT xpold  = tmp_particle_data[lev][index][TmpIdx::xold ].dataPtr();
     ParticleReal* AMREX_RESTRICT ypold  = tmp_particle_data[lev][index][TmpIdx::yold ].dataPtr();
     ParticleReal* AMREX_RESTRICT zpold  = tmp_particle_data[lev][index][TmpIdx::zold ].dataPtr();
@@ -1645,6 +1724,65 @@ void PhysicalParticleContainer::copy_attribs(WarpXParIter& pti,const ParticleRea
         );
 }
 
+/* \brief Same as copy_attribs, but only for the particles that are in the
+ *        intervals m_bfd_slabs along the boost direction. The indices of
+ *        these particles are stored in tmp_particle_index, and their
+ *        attributes are stored contiguously in tmp_particle_data.
+ */
+void PhysicalParticleContainer::copy_attribs_sparse(WarpXParIter& pti,const ParticleReal* xp,
+                                                    const ParticleReal* yp, const ParticleReal* zp)
+{
+    auto& attribs = pti.GetAttribs();
+    const ParticleReal* AMREX_RESTRICT uxp = attribs[PIdx::ux].dataPtr();
+    const ParticleReal* AMREX_RESTRICT uyp = attribs[PIdx::uy].dataPtr();
+    const ParticleReal* AMREX_RESTRICT uzp = attribs[PIdx::uz].dataPtr();
+
+    const long np = pti.numParticles();
+    const auto lev = pti.GetLevel();
+    const auto index = pti.GetPairIndex();
+    auto& pidx = tmp_particle_index[lev][index];
+    auto& tmp = tmp_particle_data[lev][index];
+    pidx.clear();
+
+    // Skip the tiles that do not intersect the slabs
+#if (AMREX_SPACEDIM == 2)
+    const int direction = 1;
+#else
+    const int direction = 2;
+#endif
+    const Box tbx = amrex::grow(pti.tilebox(), 1);
+    const RealBox tile_real_box(tbx, Geom(lev).CellSize(), Geom(lev).ProbLo());
+    const Real tile_lo = tile_real_box.lo(direction);
+    const Real tile_hi = tile_real_box.hi(direction);
+    const auto& slabs = m_bfd_slabs;
+    const bool intersects = std::any_of(slabs.begin(), slabs.end(),
+        [=] (const std::pair<Real,Real>& slab) {
+            return slab.first <= tile_hi && slab.second >= tile_lo; });
+
+    if (intersects) {
+        for (long i = 0; i < np; ++i) {
+            // First slab that ends after zp[i]
+            auto it = std::lower_bound(slabs.begin(), slabs.end(), zp[i],
+                [] (const std::pair<Real,Real>& slab, Real z) { return slab.second < z; });
+            if (it != slabs.end() && it->first <= zp[i]) pidx.push_back(i);
+        }
+    }
+
+    const long nsparse = pidx.size();
+    for (int comp = 0; comp < TmpIdx::nattribs; ++comp) {
+        tmp[comp].resize(nsparse);
+    }
+    for (long k = 0; k < nsparse; ++k) {
+        const long i = pidx[k];
+        tmp[TmpIdx::xold ][k] = xp[i];
+        tmp[TmpIdx::yold ][k] = yp[i];
+        tmp[TmpIdx::zold ][k] = zp[i];
+        tmp[TmpIdx::uxold][k] = uxp[i];
+        tmp[TmpIdx::uyold][k] = uyp[i];
+        tmp[TmpIdx::uzold][k] = uzp[i];
+    }
+}
+
 void PhysicalParticleContainer::GetParticleSlice(const int direction, const Real z_old,
                                                  const Real z_new, const Real t_boost,
                                                  const Real t_lab, const Real dt,
@@ -1725,15 +1863,25 @@ void PhysicalParticleContainer::GetParticleSlice(const int direction, const Real
 
                 const long np = pti.numParticles();
 
+                // With m_bfd_sparse, the old attributes are only stored for
+                // the particles in tmp_particle_index (the other particles
+                // cannot cross a snapshot plane). k is the index of the
+                // particle in tmp_particle_data, and i its index in the tile.
+                const long* sparse_index = m_bfd_sparse ?
+                    tmp_particle_index[lev][index].dataPtr() : nullptr;
+                const long nold = m_bfd_sparse ?
+                    static_cast<long>(tmp_particle_index[lev][index].size()) : np;
+
                 Real uzfrm = -WarpX::gamma_boost*WarpX::beta_boost*PhysConst::c;
                 Real inv_c2 = 1.0/PhysConst::c/PhysConst::c;
 
-                for (long i = 0; i < np; ++i) {
+                for (long k = 0; k < nold; ++k) {
+                    const long i = sparse_index ? sparse_index[k] : k;
 
                     // if the particle did not cross the plane of z_boost in the last
                     // timestep, skip it.
-                    if ( not (((zp_new[i] >= z_new) && (zp_old[i] <= z_old)) ||
-                              ((zp_new[i] <= z_new) && (zp_old[i] >= z_old))) ) continue;
+                    if ( not (((zp_new[i] >= z_new) && (zp_old[k] <= z_old)) ||
+                              ((zp_new[i] <= z_new) && (zp_old[k] >= z_old))) ) continue;
 
                     // Lorentz transform particles to lab frame
                     Real gamma_new_p = std::sqrt(1.0 + inv_c2*(uxp_new[i]*uxp_new[i] + uyp_new[i]*uyp_new[i] + uzp_new[i]*uzp_new[i]));
@@ -1741,21 +1889,21 @@ void PhysicalParticleContainer::GetParticleSlice(const int direction, const Real
                     Real z_new_p = WarpX::gamma_boost*(zp_new[i] + WarpX::beta_boost*PhysConst::c*t_boost);
                     Real uz_new_p = WarpX::gamma_boost*uzp_new[i] - gamma_new_p*uzfrm;
 
-                    Real gamma_old_p = std::sqrt(1.0 + inv_c2*(uxp_old[i]*uxp_old[i] + uyp_old[i]*uyp_old[i] + uzp_old[i]*uzp_old[i]));
-                    Real t_old_p = WarpX::gamma_boost*(t_boost - dt) - uzfrm*zp_old[i]*inv_c2;
-                    Real z_old_p = WarpX::gamma_boost*(zp_old[i] + WarpX::beta_boost*PhysConst::c*(t_boost-dt));
-                    Real uz_old_p = WarpX::gamma_boost*uzp_old[i] - gamma_old_p*uzfrm;
+                    Real gamma_old_p = std::sqrt(1.0 + inv_c2*(uxp_old[k]*uxp_old[k] + uyp_old[k]*uyp_old[k] + uzp_old[k]*uzp_old[k]));
+                    Real t_old_p = WarpX::gamma_boost*(t_boost - dt) - uzfrm*zp_old[k]*inv_c2;
+                    Real z_old_p = WarpX::gamma_boost*(zp_old[k] + WarpX::beta_boost*PhysConst::c*(t_boost-dt));
+                    Real uz_old_p = WarpX::gamma_boost*uzp_old[k] - gamma_old_p*uzfrm;
 
                     // interpolate in time to t_lab
                     Real weight_old = (t_new_p - t_lab) / (t_new_p - t_old_p);
                     Real weight_new = (t_lab - t_old_p) / (t_new_p - t_old_p);
 
-                    Real xp = xp_old[i]*weight_old + xp_new[i]*weight_new;
-                    Real yp = yp_old[i]*weight_old + yp_new[i]*weight_new;
+                    Real xp = xp_old[k]*weight_old + xp_new[i]*weight_new;
+                    Real yp = yp_old[k]*weight_old + yp_new[i]*weight_new;
                     Real zp = z_old_p  *weight_old + z_new_p  *weight_new;
 
-                    Real uxp = uxp_old[i]*weight_old + uxp_new[i]*weight_new;
-                    Real uyp = uyp_old[i]*weight_old + uyp_new[i]*weight_new;
+                    Real uxp = uxp_old[k]*weight_old + uxp_new[i]*weight_new;
+                    Real uyp = uyp_old[k]*weight_old + uyp_new[i]*weight_new;
                     Real uzp = uz_old_p  *weight_old + uz_new_p  *weight_new;
 
                     diagnostic_particles[lev][index].GetRealData(DiagIdx::w).push_back(wp[i]);
@@ -1773,6 +1921,206 @@ void PhysicalParticleContainer::GetParticleSlice(const int direction, const Real
     }
 }
 
+/* \brief Same as GetParticleSlice, for all the snapshots in one sweep over
+ *        the particles.
+ *
+ *  The snapshot planes are sorted by z_new. For each particle, a binary
+ *  search gives the range of snapshots whose plane could have been crossed
+ *  by the particle during the last step, and the exact test of
+ *  GetParticleSlice is only applied to these snapshots. The particle is
+ *  Lorentz-transformed once, and appended to the buffer of every snapshot
+ *  whose plane it crossed.
+ */
+void PhysicalParticleContainer::GetParticleSlices(const int direction,
+                                                  const Vector<Real>& z_old,
+                                                  const Vector<Real>& z_new,
+                                                  const Real t_boost,
+                                                  const Vector<Real>& t_lab,
+                                                  const Real dt,
+                                                  Vector<DiagnosticParticles>& diagnostic_particles)
+{
+    BL_PROFILE("PhysicalParticleContainer::GetParticleSlices");
+
+    // Assume that the boost in the positive z direction.
+#if (AMREX_SPACEDIM == 2)
+    AMREX_ALWAYS_ASSERT(direction == 1);
+#else
+    AMREX_ALWAYS_ASSERT(direction == 2);
+#endif
+
+    AMREX_ALWAYS_ASSERT(do_boosted_frame_diags == 1);
+
+    const int nsnapshots = z_old.size();
+    AMREX_ALWAYS_ASSERT(static_cast<int>(z_new.size()) == nsnapshots);
+    AMREX_ALWAYS_ASSERT(static_cast<int>(t_lab.size()) == nsnapshots);
+
+    diagnostic_particles.resize(nsnapshots);
+    for (auto& dp : diagnostic_particles) dp.resize(finestLevel()+1);
+    if (nsnapshots == 0) return;
+
+    // Sort the snapshots by z_new, and find the largest distance
+    // between z_new and z_old (the slices all move by the same distance,
+    // up to roundoff errors).
+    Vector<int> order(nsnapshots);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&z_new] (int a, int b) { return z_new[a] < z_new[b]; });
+    Vector<Real> z_new_sorted(nsnapshots);
+    Real max_width = 0.;
+    Real z_min = std::numeric_limits<Real>::max();
+    Real z_max = std::numeric_limits<Real>::lowest();
+    for (int k = 0; k < nsnapshots; ++k) {
+        const int isnap = order[k];
+        // Note the the slice should always move in the negative boost direction.
+        AMREX_ALWAYS_ASSERT(z_new[isnap] < z_old[isnap]);
+        z_new_sorted[k] = z_new[isnap];
+        max_width = std::max(max_width, z_old[isnap] - z_new[isnap]);
+        z_min = std::min(z_min, z_new[isnap]);
+        z_max = std::max(z_max, z_old[isnap]);
+    }
+
+    const int nlevs = std::max(0, finestLevel()+1);
+
+    // we figure out a box for coarse-grained rejection. If the RealBox corresponding to a
+    // given tile doesn't intersect with this, there is no need to check any particles.
+    const Real* base_dx = Geom(0).CellSize();
+    RealBox slice_box = Geom(0).ProbDomain();
+    slice_box.setLo(direction, z_min - base_dx[direction]);
+    slice_box.setHi(direction, z_max + base_dx[direction]);
+
+    for (int lev = 0; lev < nlevs; ++lev) {
+
+        const Real* dx  = Geom(lev).CellSize();
+        const Real* plo = Geom(lev).ProbLo();
+
+        // first we touch each map entry in serial
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            auto index = std::make_pair(pti.index(), pti.LocalTileIndex());
+            for (auto& dp : diagnostic_particles) dp[lev][index];
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            RealVector xp_new, yp_new, zp_new;
+            Vector<DiagnosticParticleData*> tile_data(nsnapshots);
+
+            for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+            {
+                const Box& box = pti.validbox();
+
+                auto index = std::make_pair(pti.index(), pti.LocalTileIndex());
+
+                const RealBox tile_real_box(box, dx, plo);
+
+                if ( !slice_box.intersects(tile_real_box) ) continue;
+
+                for (int isnap = 0; isnap < nsnapshots; ++isnap) {
+                    tile_data[isnap] = &diagnostic_particles[isnap][lev][index];
+                }
+
+                pti.GetPosition(xp_new, yp_new, zp_new);
+
+                auto& attribs = pti.GetAttribs();
+
+                auto& wp = attribs[PIdx::w ];
+
+                auto& uxp_new = attribs[PIdx::ux   ];
+                auto& uyp_new = attribs[PIdx::uy   ];
+                auto& uzp_new = attribs[PIdx::uz   ];
+
+                auto&  xp_old = tmp_particle_data[lev][index][TmpIdx::xold];
+                auto&  yp_old = tmp_particle_data[lev][index][TmpIdx::yold];
+                auto&  zp_old = tmp_particle_data[lev][index][TmpIdx::zold];
+                auto& uxp_old = tmp_particle_data[lev][index][TmpIdx::uxold];
+                auto& uyp_old = tmp_particle_data[lev][index][TmpIdx::uyold];
+                auto& uzp_old = tmp_particle_data[lev][index][TmpIdx::uzold];
+
+                const long np = pti.numParticles();
+
+                // With m_bfd_sparse, the old attributes are only stored for
+                // the particles in tmp_particle_index (the other particles
+                // cannot cross a snapshot plane). k is the index of the
+                // particle in tmp_particle_data, and i its index in the tile.
+                const long* sparse_index = m_bfd_sparse ?
+                    tmp_particle_index[lev][index].dataPtr() : nullptr;
+                const long nold = m_bfd_sparse ?
+                    static_cast<long>(tmp_particle_index[lev][index].size()) : np;
+
+                Real uzfrm = -WarpX::gamma_boost*WarpX::beta_boost*PhysConst::c;
+                Real inv_c2 = 1.0/PhysConst::c/PhysConst::c;
+
+                for (long k = 0; k < nold; ++k) {
+                    const long i = sparse_index ? sparse_index[k] : k;
+
+                    // Only the snapshots with
+                    // min(zp_new,zp_old) - max_width <= z_new <= max(zp_new,zp_old)
+                    // can have a plane crossed by the particle.
+                    const Real zp_lo = std::min(zp_new[i], zp_old[k]);
+                    const Real zp_hi = std::max(zp_new[i], zp_old[k]);
+                    const int kbegin = std::lower_bound(z_new_sorted.begin(), z_new_sorted.end(),
+                                                        zp_lo - max_width) - z_new_sorted.begin();
+                    const int kend = std::upper_bound(z_new_sorted.begin(), z_new_sorted.end(),
+                                                      zp_hi) - z_new_sorted.begin();
+                    if (kbegin >= kend) continue;
+
+                    bool transformed = false;
+                    Real t_new_p, z_new_p, uz_new_p, t_old_p, z_old_p, uz_old_p;
+
+                    for (int ks = kbegin; ks < kend; ++ks) {
+                        const int isnap = order[ks];
+
+                        // if the particle did not cross the plane of z_boost in the last
+                        // timestep, skip it.
+                        if ( not (((zp_new[i] >= z_new[isnap]) && (zp_old[k] <= z_old[isnap])) ||
+                                  ((zp_new[i] <= z_new[isnap]) && (zp_old[k] >= z_old[isnap]))) ) continue;
+
+                        // Lorentz transform particles to lab frame
+                        if (not transformed) {
+                            Real gamma_new_p = std::sqrt(1.0 + inv_c2*(uxp_new[i]*uxp_new[i] + uyp_new[i]*uyp_new[i] + uzp_new[i]*uzp_new[i]));
+                            t_new_p = WarpX::gamma_boost*t_boost - uzfrm*zp_new[i]*inv_c2;
+                            z_new_p = WarpX::gamma_boost*(zp_new[i] + WarpX::beta_boost*PhysConst::c*t_boost);
+                            uz_new_p = WarpX::gamma_boost*uzp_new[i] - gamma_new_p*uzfrm;
+
+                            Real gamma_old_p = std::sqrt(1.0 + inv_c2*(uxp_old[k]*uxp_old[k] + uyp_old[k]*uyp_old[k] + uzp_old[k]*uzp_old[k]));
+                            t_old_p = WarpX::gamma_boost*(t_boost - dt) - uzfrm*zp_old[k]*inv_c2;
+                            z_old_p = WarpX::gamma_boost*(zp_old[k] + WarpX::beta_boost*PhysConst::c*(t_boost-dt));
+                            uz_old_p = WarpX::gamma_boost*uzp_old[k] - gamma_old_p*uzfrm;
+                            transformed = true;
+                        }
+
+                        // interpolate in time to t_lab
+                        Real weight_old = (t_new_p - t_lab[isnap]) / (t_new_p - t_old_p);
+                        Real weight_new = (t_lab[isnap] - t_old_p) / (t_new_p - t_old_p);
+
+                        Real xp = xp_old[k]*weight_old + xp_new[i]*weight_new;
+                        Real yp = yp_old[k]*weight_old + yp_new[i]*weight_new;
+                        Real zp = z_old_p  *weight_old + z_new_p  *weight_new;
+
+                        Real uxp = uxp_old[k]*weight_old + uxp_new[i]*weight_new;
+                        Real uyp = uyp_old[k]*weight_old + uyp_new[i]*weight_new;
+                        Real uzp = uz_old_p  *weight_old + uz_new_p  *weight_new;
+
+                        DiagnosticParticleData& pdata = *tile_data[isnap];
+
+                        pdata.GetRealData(DiagIdx::w).push_back(wp[i]);
+
+                        pdata.GetRealData(DiagIdx::x).push_back(xp);
+                        pdata.GetRealData(DiagIdx::y).push_back(yp);
+                        pdata.GetRealData(DiagIdx::z).push_back(zp);
+
+                        pdata.GetRealData(DiagIdx::ux).push_back(uxp);
+                        pdata.GetRealData(DiagIdx::uy).push_back(uyp);
+                        pdata.GetRealData(DiagIdx::uz).push_back(uzp);
+                    }
+                }
+            }
+        }
+    }
+}
+
 /* \brief Inject particles during the simulation
  * \param injection_box: domain where particles should be injected.
  */
@@ -1916,6 +2264,163 @@ PhysicalParticleContainer::FieldGather (WarpXParIter& pti,
 }
 
 
+/* \brief Gather fields, push particles and deposit current for all particles
+ *        of a tile, in a single pass over the particles.
+ *        This gives the same result as FieldGather, PushPX and DepositCurrent
+ *        called one after the other, but reads and writes the particle
+ *        arrays only once. Positions are read from and written to
+ *        m_xp[thread_num], m_yp[thread_num] and m_zp[thread_num].
+ * \param pti: Particle iterator
+ * \param wp, uxp, uyp, uzp: Particle weights and momenta (momenta are updated)
+ * \param Exp, Eyp, Ezp, Bxp, Byp, Bzp: Fields on particles (filled by the gather
+ *        only if the fields are stored on the particles)
+ * \param ion_lev: Pointer to the ionization level, or nullptr
+ * \param exfab, eyfab, ezfab, bxfab, byfab, bzfab: Fields to gather
+ * \param ngE: Number of guard cells of the fields
+ * \param e_is_nodal: 1 if the fields are nodal, 0 otherwise
+ * \param jx, jy, jz: Current density, into which the particles deposit
+ * \param thread_num: if using OpenMP, thread number
+ * \param lev: level on which particles are located
+ * \param dt: time step by which particles are advanced
+ * \param a_dt_type: type of time step (used for the boosted-frame diagnostic)
+ * \param deposit_in_place: Deposit directly in jx, jy, jz instead of
+ *        per-thread buffers (see WarpXParticleContainer::DepositCurrent)
+ */
+void
+PhysicalParticleContainer::FusedGatherPushDeposit (WarpXParIter& pti,
+                                                   RealVector& wp,
+                                                   RealVector& uxp,
+                                                   RealVector& uyp,
+                                                   RealVector& uzp,
+                                                   RealVector& Exp,
+                                                   RealVector& Eyp,
+                                                   RealVector& Ezp,
+                                                   RealVector& Bxp,
+                                                   RealVector& Byp,
+                                                   RealVector& Bzp,
+                                                   const int * const ion_lev,
+                                                   FArrayBox const * exfab,
+                                                   FArrayBox const * eyfab,
+                                                   FArrayBox const * ezfab,
+                                                   FArrayBox const * bxfab,
+                                                   FArrayBox const * byfab,
+                                                   FArrayBox const * bzfab,
+                                                   const int ngE, const int e_is_nodal,
+                                                   MultiFab* jx, MultiFab* jy, MultiFab* jz,
+                                                   int thread_num, int lev, Real dt,
+                                                   DtType a_dt_type, bool deposit_in_place)
+{
+    const long np = pti.numParticles();
+    // If no particles, do not do anything
+    if (np == 0) return;
+
+    ParticleReal* const AMREX_RESTRICT xp = m_xp[thread_num].dataPtr();
+    ParticleReal* const AMREX_RESTRICT yp = m_yp[thread_num].dataPtr();
+    ParticleReal* const AMREX_RESTRICT zp = m_zp[thread_num].dataPtr();
+
+    // Store the positions before the push, as PushPX does
+    if (WarpX::do_boosted_frame_diagnostic && do_boosted_frame_diags && (a_dt_type!=DtType::SecondHalf))
+    {
+        copy_attribs(pti, xp, yp, zp);
+    }
+
+    const std::array<Real,3>& dx = WarpX::CellSize(lev);
+    const Real q = this->charge;
+    const Real m = this->mass;
+
+    // Box from which the fields are gathered, including guard cells
+    Box gather_box = pti.tilebox();
+    gather_box.grow(ngE);
+    const std::array<Real, 3>& xyzmin_gather = WarpX::LowerCorner(gather_box, lev);
+    const Dim3 lo_gather = lbound(gather_box);
+    const Real e_stagger_shift = e_is_nodal ? 0.0 : 0.5;
+
+    const Array4<const Real>& ex_arr = exfab->array();
+    const Array4<const Real>& ey_arr = eyfab->array();
+    const Array4<const Real>& ez_arr = ezfab->array();
+    const Array4<const Real>& bx_arr = bxfab->array();
+    const Array4<const Real>& by_arr = byfab->array();
+    const Array4<const Real>& bz_arr = bzfab->array();
+
+    // Box into which the current is deposited, including guard cells
+    const long ngJ = jx->nGrow();
+    const int j_is_nodal = jx->is_nodal() and jy->is_nodal() and jz->is_nodal();
+    const Real j_stagger_shift = j_is_nodal ? 0.0 : 0.5;
+    Box depos_box = pti.tilebox();
+    Box tbx = convert(depos_box, WarpX::jx_nodal_flag);
+    Box tby = convert(depos_box, WarpX::jy_nodal_flag);
+    Box tbz = convert(depos_box, WarpX::jz_nodal_flag);
+    depos_box.grow(ngJ);
+    const std::array<Real, 3>& xyzmin_depos = WarpX::LowerCorner(depos_box, lev);
+    const Dim3 lo_depos = lbound(depos_box);
+
+#ifdef AMREX_USE_GPU
+    // No tiling on GPU: deposit directly in jx, jy, jz
+    deposit_in_place = true;
+#endif
+
+    Array4<Real> jx_arr, jy_arr, jz_arr;
+    if (deposit_in_place) {
+        jx_arr = jx->array(pti);
+        jy_arr = jy->array(pti);
+        jz_arr = jz->array(pti);
+    } else {
+        // Tiling is on: deposit in local_jx[thread_num] (same for jy, jz)
+        tbx.grow(ngJ);
+        tby.grow(ngJ);
+        tbz.grow(ngJ);
+
+        local_jx[thread_num].resize(tbx, jx->nComp());
+        local_jy[thread_num].resize(tby, jy->nComp());
+        local_jz[thread_num].resize(tbz, jz->nComp());
+
+        local_jx[thread_num].setVal(0.0);
+        local_jy[thread_num].setVal(0.0);
+        local_jz[thread_num].setVal(0.0);
+
+        jx_arr = local_jx[thread_num].array();
+        jy_arr = local_jy[thread_num].array();
+        jz_arr = local_jz[thread_num].array();
+    }
+
+    // The gathered fields are only written out if they are stored on the
+    // particles; otherwise they stay in registers.
+    ParticleReal* Ex_ptr = nullptr;
+    ParticleReal* Ey_ptr = nullptr;
+    ParticleReal* Ez_ptr = nullptr;
+    ParticleReal* Bx_ptr = nullptr;
+    ParticleReal* By_ptr = nullptr;
+    ParticleReal* Bz_ptr = nullptr;
+    if (m_store_fields_on_particles) {
+        Ex_ptr = Exp.dataPtr();
+        Ey_ptr = Eyp.dataPtr();
+        Ez_ptr = Ezp.dataPtr();
+        Bx_ptr = Bxp.dataPtr();
+        By_ptr = Byp.dataPtr();
+        Bz_ptr = Bzp.dataPtr();
+    }
+
+    // Call the version of doFusedGatherPushDepositShapeN for WarpX::nox,
+    // l_lower_order_in_v, the particle pusher and the current deposition
+    doFusedGatherPushDeposit(
+        WarpX::nox, WarpX::l_lower_order_in_v,
+        WarpX::particle_pusher_algo, WarpX::current_deposition_algo,
+        xp, yp, zp, wp.dataPtr(), uxp.dataPtr(), uyp.dataPtr(), uzp.dataPtr(),
+        Ex_ptr, Ey_ptr, Ez_ptr, Bx_ptr, By_ptr, Bz_ptr, ion_lev,
+        ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+        jx_arr, jy_arr, jz_arr, np, dx,
+        xyzmin_gather, lo_gather, e_stagger_shift,
+        xyzmin_depos, lo_depos, j_stagger_shift,
+        q, m, dt, WarpX::n_rz_azimuthal_modes);
+
+    if (!deposit_in_place) {
+        // CPU, tiling: atomicAdd local_jx into jx (same for jy, jz)
+        (*jx)[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
+        (*jy)[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
+        (*jz)[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
+    }
+}
+
 void PhysicalParticleContainer::InitIonizationModule ()
 {
     if (!do_field_ionization) return;
@@ -2001,12 +2506,14 @@ PhysicalParticleContainer::buildIonizationMask (const amrex::MFIter& mfi, const
     const ParticleReal * const AMREX_RESTRICT ux = soa.GetRealData(PIdx::ux).data();
     const ParticleReal * const AMREX_RESTRICT uy = soa.GetRealData(PIdx::uy).data();
     const ParticleReal * const AMREX_RESTRICT uz = soa.GetRealData(PIdx::uz).data();
-    const ParticleReal * const AMREX_RESTRICT ex = soa.GetRealData(PIdx::Ex).data();
-    const ParticleReal * const AMREX_RESTRICT ey = soa.GetRealData(PIdx::Ey).data();
-    const ParticleReal * const AMREX_RESTRICT ez = soa.GetRealData(PIdx::Ez).data();
-    const ParticleReal * const AMREX_RESTRICT bx = soa.GetRealData(PIdx::Bx).data();
-    const ParticleReal * const AMREX_RESTRICT by = soa.GetRealData(PIdx::By).data();
-    const ParticleReal * const AMREX_RESTRICT bz = soa.GetRealData(PIdx::Bz).data();
+    // The fields are stored on the particles of ionizable species
+    // (see StoreFieldsOnParticles in the constructor)
+    const ParticleReal * const AMREX_RESTRICT ex = soa.GetRealData(particle_comps["Ex"]).data();
+    const ParticleReal * const AMREX_RESTRICT ey = soa.GetRealData(particle_comps["Ey"]).data();
+    const ParticleReal * const AMREX_RESTRICT ez = soa.GetRealData(particle_comps["Ez"]).data();
+    const ParticleReal * const AMREX_RESTRICT bx = soa.GetRealData(particle_comps["Bx"]).data();
+    const ParticleReal * const AMREX_RESTRICT by = soa.GetRealData(particle_comps["By"]).data();
+    const ParticleReal * const AMREX_RESTRICT bz = soa.GetRealData(particle_comps["Bz"]).data();
     int* ion_lev = soa.GetIntData(particle_icomps["ionization_level"]).data();
 
     Real c = PhysConst::c;
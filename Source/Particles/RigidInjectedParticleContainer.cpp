@@ -28,6 +28,8 @@ RigidInjectedParticleContainer::RigidInjectedParticleContainer (AmrCore* amr_cor
     pp.query("focused", focused);
     pp.query("rigid_advance", rigid_advance);
 
+    // The rigid advance is done in RigidInjectedParticleContainer::PushPX
+    m_can_fuse_gather_push_deposit = false;
 }
 
 void RigidInjectedParticleContainer::InitData()
@@ -210,6 +212,8 @@ RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
                                        Cuda::ManagedDeviceVector<ParticleReal>& xp,
                                        Cuda::ManagedDeviceVector<ParticleReal>& yp,
                                        Cuda::ManagedDeviceVector<ParticleReal>& zp,
+                                       RealVector& Exp, RealVector& Eyp, RealVector& Ezp,
+                                       RealVector& Bxp, RealVector& Byp, RealVector& Bzp,
                                        Real dt, DtType a_dt_type)
 {
 
@@ -229,12 +233,12 @@ RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
     ParticleReal* const AMREX_RESTRICT ux = uxp.dataPtr();
     ParticleReal* const AMREX_RESTRICT uy = uyp.dataPtr();
     ParticleReal* const AMREX_RESTRICT uz = uzp.dataPtr();
-    ParticleReal* const AMREX_RESTRICT Exp = attribs[PIdx::Ex].dataPtr();
-    ParticleReal* const AMREX_RESTRICT Eyp = attribs[PIdx::Ey].dataPtr();
-    ParticleReal* const AMREX_RESTRICT Ezp = attribs[PIdx::Ez].dataPtr();
-    ParticleReal* const AMREX_RESTRICT Bxp = attribs[PIdx::Bx].dataPtr();
-    ParticleReal* const AMREX_RESTRICT Byp = attribs[PIdx::By].dataPtr();
-    ParticleReal* const AMREX_RESTRICT Bzp = attribs[PIdx::Bz].dataPtr();
+    ParticleReal* const AMREX_RESTRICT Expp = Exp.dataPtr();
+    ParticleReal* const AMREX_RESTRICT Eypp = Eyp.dataPtr();
+    ParticleReal* const AMREX_RESTRICT Ezpp = Ezp.dataPtr();
+    ParticleReal* const AMREX_RESTRICT Bxpp = Bxp.dataPtr();
+    ParticleReal* const AMREX_RESTRICT Bypp = Byp.dataPtr();
+    ParticleReal* const AMREX_RESTRICT Bzpp = Bzp.dataPtr();
 
     if (!done_injecting_lev) {
         // If the old values are not already saved, create copies here.
@@ -256,18 +260,19 @@ RigidInjectedParticleContainer::PushPX(WarpXParIter& pti,
             [=] AMREX_GPU_DEVICE (long i) {
             const Real dtscale = dt - (z_plane_previous - z[i])/(vz_ave_boosted + v_boost);
             if (0. < dtscale && dtscale < dt) {
-                Exp[i] *= dtscale;
-                Eyp[i] *= dtscale;
-                Ezp[i] *= dtscale;
-                Bxp[i] *= dtscale;
-                Byp[i] *= dtscale;
-                Bzp[i] *= dtscale;
+                Expp[i] *= dtscale;
+                Eypp[i] *= dtscale;
+                Ezpp[i] *= dtscale;
+                Bxpp[i] *= dtscale;
+                Bypp[i] *= dtscale;
+                Bzpp[i] *= dtscale;
             }
         }
         );
     }
 
-    PhysicalParticleContainer::PushPX(pti, xp, yp, zp, dt, a_dt_type);
+    PhysicalParticleContainer::PushPX(pti, xp, yp, zp,
+                                      Exp, Eyp, Ezp, Bxp, Byp, Bzp, dt, a_dt_type);
 
     if (!done_injecting_lev) {
 
@@ -373,12 +378,12 @@ RigidInjectedParticleContainer::PushP (int lev, Real dt,
             auto& uxp = attribs[PIdx::ux];
             auto& uyp = attribs[PIdx::uy];
             auto& uzp = attribs[PIdx::uz];
-            auto& Exp = attribs[PIdx::Ex];
-            auto& Eyp = attribs[PIdx::Ey];
-            auto& Ezp = attribs[PIdx::Ez];
-            auto& Bxp = attribs[PIdx::Bx];
-            auto& Byp = attribs[PIdx::By];
-            auto& Bzp = attribs[PIdx::Bz];
+            auto& Exp = GetFieldOnParticles(pti, FieldIdx::Ex, thread_num);
+            auto& Eyp = GetFieldOnParticles(pti, FieldIdx::Ey, thread_num);
+            auto& Ezp = GetFieldOnParticles(pti, FieldIdx::Ez, thread_num);
+            auto& Bxp = GetFieldOnParticles(pti, FieldIdx::Bx, thread_num);
+            auto& Byp = GetFieldOnParticles(pti, FieldIdx::By, thread_num);
+            auto& Bzp = GetFieldOnParticles(pti, FieldIdx::Bz, thread_num);
 
             const long np = pti.numParticles();
 
@@ -0,0 +1,125 @@
+#include <SortingUtils.H>
+#include <WarpXParticleContainer.H>
+#include <AMReX_Particles.H>
+
+#include <algorithm>
+#include <limits>
+
+using namespace amrex;
+
+/* \brief Sort the particles of each tile by cell, starting from the
+ *        current order of the particles.
+ *
+ *  Particles move by at most one cell per step, so that particles sorted
+ *  by cell at the previous step are still mostly sorted. For each tile:
+ *  - The tile is skipped if its particles are still sorted by cell.
+ *  - Otherwise, the particles that are in order are kept in place, and
+ *    the particles that crossed into a cell out of order (or that were
+ *    moved by Redistribute) are set aside. Only these particles are sorted,
+ *    and then merged with the particles in order.
+ *  This is much cheaper than SortParticlesByCell when few particles
+ *  crossed cells since the last sort.
+ *
+ *  On GPU, this calls SortParticlesByCell, since the search for the
+ *  particles out of order is sequential.
+ */
+void
+WarpXParticleContainer::SortParticlesByCellIncremental ()
+{
+    BL_PROFILE("WPC::SortParticlesByCellIncremental()");
+
+#ifdef AMREX_USE_GPU
+    SortParticlesByCell();
+#else
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        const Geometry& geom = Geom(lev);
+        const Box& domain = geom.Domain();
+        GpuArray<Real,AMREX_SPACEDIM> prob_lo;
+        GpuArray<Real,AMREX_SPACEDIM> inv_cell_size;
+        for (int idim=0; idim<AMREX_SPACEDIM; idim++) {
+            prob_lo[idim] = geom.ProbLo(idim);
+            inv_cell_size[idim] = geom.InvCellSize(idim);
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            Vector<long> cell;
+            Vector<long> displaced;
+            Gpu::DeviceVector<long> pid;
+
+            for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+            {
+                const long np = pti.numParticles();
+                if (np < 2) continue;
+
+                // Index of the cell of each particle, in the tile box
+                const Box& tbx = pti.tilebox();
+                auto& aos = pti.GetArrayOfStructs();
+                cell.resize(np);
+                for (long i = 0; i < np; ++i) {
+                    IntVect iv = getParticleCell(aos[i], prob_lo, inv_cell_size, domain);
+                    iv.min(tbx.bigEnd());
+                    iv.max(tbx.smallEnd());
+                    cell[i] = tbx.index(iv);
+                }
+
+                if (std::is_sorted(cell.begin(), cell.end())) continue;
+
+                // Keep the particles that are in order with respect to the
+                // last particle kept and to the next particle. The other
+                // particles are out of order and are set aside.
+                pid.resize(np);
+                displaced.clear();
+                long nkept = 0;
+                long last_cell = std::numeric_limits<long>::lowest();
+                for (long i = 0; i < np; ++i) {
+                    if (cell[i] >= last_cell && (i == np-1 || cell[i] <= cell[i+1])) {
+                        pid[nkept++] = i;
+                        last_cell = cell[i];
+                    } else {
+                        displaced.push_back(i);
+                    }
+                }
+
+                // Sort the particles out of order, and merge them with the
+                // particles in order. At the end of this step, `pid` contains
+                // the indices that should be used to reorder the particles.
+                auto by_cell = [&cell] (long a, long b) { return cell[a] < cell[b]; };
+                std::stable_sort(displaced.begin(), displaced.end(), by_cell);
+                std::copy(displaced.begin(), displaced.end(), pid.begin() + nkept);
+                std::inplace_merge(pid.begin(), pid.begin() + nkept, pid.end(), by_cell);
+
+                // Reorder the particle AoS
+                ParticleVector particle_tmp;
+                particle_tmp.resize(np);
+                amrex::ParallelFor( np,
+                    copyAndReorder<ParticleType>( aos(), particle_tmp, pid ) );
+                std::swap(aos(), particle_tmp);
+
+                // Reorder all the real and integer components, including
+                // the runtime components
+                auto& soa = pti.GetStructOfArrays();
+                RealVector rtmp;
+                rtmp.resize(np);
+                for (int comp = 0; comp < NumRealComps(); ++comp) {
+                    auto& rdata = soa.GetRealData(comp);
+                    amrex::ParallelFor( np,
+                        copyAndReorder<ParticleReal>( rdata, rtmp, pid ) );
+                    std::swap(rdata, rtmp);
+                }
+                Gpu::ManagedDeviceVector<int> itmp;
+                itmp.resize(np);
+                for (int comp = 0; comp < NumIntComps(); ++comp) {
+                    auto& idata = soa.GetIntData(comp);
+                    amrex::ParallelFor( np,
+                        copyAndReorder<int>( idata, itmp, pid ) );
+                    std::swap(idata, itmp);
+                }
+            }
+        }
+    }
+#endif
+}
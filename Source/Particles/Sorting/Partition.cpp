@@ -130,13 +130,13 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
         tmp.resize(np);
 
         // Copy individual attributes
-        amrex::ParallelFor( np, copyAndReorder<Real>( wp, tmp, pid ) );
+        amrex::ParallelFor( np, copyAndReorder<ParticleReal>( wp, tmp, pid ) );
         std::swap(wp, tmp);
-        amrex::ParallelFor( np, copyAndReorder<Real>( uxp, tmp, pid ) );
+        amrex::ParallelFor( np, copyAndReorder<ParticleReal>( uxp, tmp, pid ) );
         std::swap(uxp, tmp);
-        amrex::ParallelFor( np, copyAndReorder<Real>( uyp, tmp, pid ) );
+        amrex::ParallelFor( np, copyAndReorder<ParticleReal>( uyp, tmp, pid ) );
         std::swap(uyp, tmp);
-        amrex::ParallelFor( np, copyAndReorder<Real>( uzp, tmp, pid ) );
+        amrex::ParallelFor( np, copyAndReorder<ParticleReal>( uzp, tmp, pid ) );
         std::swap(uzp, tmp);
 
         // Make sure that the temporary arrays are not destroyed before
@@ -17,6 +17,9 @@
 using namespace amrex;
 
 int WarpXParticleContainer::do_not_push = 0;
+int WarpXParticleContainer::do_fused_gather_push_deposit = 0;
+int WarpXParticleContainer::do_tile_coloring = 0;
+int WarpXParticleContainer::do_sorted_deposition = 0;
 
 WarpXParIter::WarpXParIter (ContainerType& pc, int level)
     : ParIter(pc, level, MFItInfo().SetDynamic(WarpX::do_dynamic_scheduling))
@@ -68,9 +71,6 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     : ParticleContainer<0,0,PIdx::nattribs>(amr_core->GetParGDB())
     , species_id(ispecies)
 {
-    for (unsigned int i = PIdx::Ex; i <= PIdx::Bz; ++i) {
-        communicate_real_comp[i] = false; // Don't need to communicate E and B.
-    }
     SetParticleSize();
     ReadParameters();
 
@@ -79,12 +79,6 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     particle_comps["ux"] = PIdx::ux;
     particle_comps["uy"] = PIdx::uy;
     particle_comps["uz"] = PIdx::uz;
-    particle_comps["Ex"] = PIdx::Ex;
-    particle_comps["Ey"] = PIdx::Ey;
-    particle_comps["Ez"] = PIdx::Ez;
-    particle_comps["Bx"] = PIdx::Bx;
-    particle_comps["By"] = PIdx::By;
-    particle_comps["Bz"] = PIdx::Bz;
 #ifdef WARPX_DIM_RZ
     particle_comps["theta"] = PIdx::theta;
 #endif
@@ -103,6 +97,33 @@ WarpXParticleContainer::WarpXParticleContainer (AmrCore* amr_core, int ispecies)
     m_xp.resize(num_threads);
     m_yp.resize(num_threads);
     m_zp.resize(num_threads);
+    m_field_scratch.resize(num_threads);
+
+#if defined(WARPX_USE_PY) || defined(WARPX_DO_ELECTROSTATIC)
+    // Python may access the fields on the particles at any time, and the
+    // electrostatic solver gathers and pushes in separate particle loops.
+    StoreFieldsOnParticles();
+#endif
+}
+
+void
+WarpXParticleContainer::StoreFieldsOnParticles ()
+{
+    if (m_store_fields_on_particles) return;
+    for (int i = 0; i < FieldIdx::nfields; ++i) {
+        // Don't need to communicate E and B.
+        AddRealComp(ParticleStringNames::field_names[i], false);
+    }
+    m_store_fields_on_particles = true;
+}
+
+WarpXParticleContainer::RealVector&
+WarpXParticleContainer::GetFieldOnParticles (WarpXParIter& pti, int comp, int thread_num)
+{
+    if (m_store_fields_on_particles) {
+        return pti.GetAttribs(particle_comps[ParticleStringNames::field_names[comp]]);
+    }
+    return m_field_scratch[thread_num][comp];
 }
 
 void
@@ -120,6 +141,9 @@ WarpXParticleContainer::ReadParameters ()
 #endif
         pp.query("do_tiling",  do_tiling);
         pp.query("do_not_push", do_not_push);
+        pp.query("do_fused_gather_push_deposit", do_fused_gather_push_deposit);
+        pp.query("do_tile_coloring", do_tile_coloring);
+        pp.query("do_sorted_deposition", do_sorted_deposition);
 
         initialized = true;
     }
@@ -292,6 +316,9 @@ WarpXParticleContainer::AddNParticles (int lev,
  * \param lev         : Level of box that contains particles
  * \param depos_lev   : Level on which particles deposit (if buffers are used)
  * \param dt          : Time step for particle level
+ * \param deposit_in_place: Deposit directly in jx, jy, jz instead of
+                        per-thread buffers. Only safe if no other thread
+                        deposits in the same cells (see TileColor).
  */
 void
 WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
@@ -301,7 +328,7 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
                                        MultiFab* jx, MultiFab* jy, MultiFab* jz,
                                        const long offset, const long np_to_depose,
                                        int thread_num, int lev, int depos_lev,
-                                       Real dt)
+                                       Real dt, bool deposit_in_place)
 {
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE((depos_lev==(lev-1)) ||
                                      (depos_lev==(lev  )),
@@ -337,32 +364,37 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
     tilebox.grow(ngJ);
 
 #ifdef AMREX_USE_GPU
-    // No tiling on GPU: jx_ptr points to the full
-    // jx array (same for jy_ptr and jz_ptr).
-    Array4<Real> const& jx_arr = jx->array(pti);
-    Array4<Real> const& jy_arr = jy->array(pti);
-    Array4<Real> const& jz_arr = jz->array(pti);
-#else
-    // Tiling is on: jx_ptr points to local_jx[thread_num]
-    // (same for jy_ptr and jz_ptr)
-    tbx.grow(ngJ);
-    tby.grow(ngJ);
-    tbz.grow(ngJ);
-
-    local_jx[thread_num].resize(tbx, jx->nComp());
-    local_jy[thread_num].resize(tby, jy->nComp());
-    local_jz[thread_num].resize(tbz, jz->nComp());
-
-    // local_jx[thread_num] is set to zero
-    local_jx[thread_num].setVal(0.0);
-    local_jy[thread_num].setVal(0.0);
-    local_jz[thread_num].setVal(0.0);
-
-    Array4<Real> const& jx_arr = local_jx[thread_num].array();
-    Array4<Real> const& jy_arr = local_jy[thread_num].array();
-    Array4<Real> const& jz_arr = local_jz[thread_num].array();
+    // No tiling on GPU: always deposit in the full jx array
+    deposit_in_place = true;
 #endif
-    // GPU, no tiling: deposit directly in jx
+
+    Array4<Real> jx_arr, jy_arr, jz_arr;
+    if (deposit_in_place) {
+        // jx_arr points to the full jx array (same for jy_arr and jz_arr)
+        jx_arr = jx->array(pti);
+        jy_arr = jy->array(pti);
+        jz_arr = jz->array(pti);
+    } else {
+        // Tiling is on: jx_arr points to local_jx[thread_num]
+        // (same for jy_arr and jz_arr)
+        tbx.grow(ngJ);
+        tby.grow(ngJ);
+        tbz.grow(ngJ);
+
+        local_jx[thread_num].resize(tbx, jx->nComp());
+        local_jy[thread_num].resize(tby, jy->nComp());
+        local_jz[thread_num].resize(tbz, jz->nComp());
+
+        // local_jx[thread_num] is set to zero
+        local_jx[thread_num].setVal(0.0);
+        local_jy[thread_num].setVal(0.0);
+        local_jz[thread_num].setVal(0.0);
+
+        jx_arr = local_jx[thread_num].array();
+        jy_arr = local_jy[thread_num].array();
+        jz_arr = local_jz[thread_num].array();
+    }
+    // GPU, no tiling, or tile coloring: deposit directly in jx
     // CPU, tiling: deposit into local_jx
     // (same for jx and jz)
 
@@ -380,6 +412,14 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
     // Better for memory? worth trying?
     const Dim3 lo = lbound(tilebox);
 
+    // On CPU, the direct deposition can group particles sorted by cell
+    // (no atomics: jx_arr is either local_jx or a tile of its own color)
+#ifdef AMREX_USE_GPU
+    const bool use_sorted_deposition = false;
+#else
+    const bool use_sorted_deposition = do_sorted_deposition;
+#endif
+
     BL_PROFILE_VAR_START(blp_deposit);
     if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Esirkepov) {
         if        (WarpX::nox == 1){
@@ -401,6 +441,26 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
                 jx_arr, jy_arr, jz_arr, np_to_depose, dt, dx, xyzmin, lo, q,
                 WarpX::n_rz_azimuthal_modes);
         }
+    } else if (use_sorted_deposition) {
+        if        (WarpX::nox == 1){
+            doDepositionShapeNSorted<1>(
+                xp, yp, zp, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_arr, jy_arr, jz_arr, np_to_depose, dt, dx, xyzmin, lo,
+                stagger_shift, q);
+        } else if (WarpX::nox == 2){
+            doDepositionShapeNSorted<2>(
+                xp, yp, zp, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_arr, jy_arr, jz_arr, np_to_depose, dt, dx, xyzmin, lo,
+                stagger_shift, q);
+        } else if (WarpX::nox == 3){
+            doDepositionShapeNSorted<3>(
+                xp, yp, zp, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                jx_arr, jy_arr, jz_arr, np_to_depose, dt, dx, xyzmin, lo,
+                stagger_shift, q);
+        }
     } else {
         if        (WarpX::nox == 1){
             doDepositionShapeN<1>(
@@ -424,17 +484,50 @@ WarpXParticleContainer::DepositCurrent(WarpXParIter& pti,
     }
     BL_PROFILE_VAR_STOP(blp_deposit);
 
-#ifndef AMREX_USE_GPU
-    BL_PROFILE_VAR_START(blp_accumulate);
-    // CPU, tiling: atomicAdd local_jx into jx
-    // (same for jx and jz)
-    (*jx)[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
-    (*jy)[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
-    (*jz)[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
-    BL_PROFILE_VAR_STOP(blp_accumulate);
+    if (!deposit_in_place) {
+        BL_PROFILE_VAR_START(blp_accumulate);
+        // CPU, tiling: atomicAdd local_jx into jx
+        // (same for jx and jz)
+        (*jx)[pti].atomicAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
+        (*jy)[pti].atomicAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
+        (*jz)[pti].atomicAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
+        BL_PROFILE_VAR_STOP(blp_accumulate);
+    }
+}
+
+bool
+WarpXParticleContainer::UseTileColoring (const MultiFab& jx) const
+{
+#ifdef AMREX_USE_GPU
+    // No tiling on GPU
+    return false;
+#else
+    if (!do_tile_coloring || !do_tiling) return false;
+    // A tile deposits in its tile box grown by the number of guard cells
+    // of J. Tiles with the same color are separated by at least one tile,
+    // which is at least tile_size wide, so their deposition boxes do not
+    // overlap if tile_size > 2*nGrow.
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (tile_size[idim] <= 2*jx.nGrow()) return false;
+    }
+    return true;
 #endif
 }
 
+int
+WarpXParticleContainer::TileColor (const WarpXParIter& pti) const
+{
+    // AMReX tiles are at least tile_size wide (unless the box itself is
+    // smaller), so this gives the index of the tile in the box along each
+    // direction. The color alternates between neighboring tiles.
+    const IntVect tile_index = (pti.tilebox().smallEnd() - pti.validbox().smallEnd()) / tile_size;
+    int color = 0;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        color += (tile_index[idim] % 2) << idim;
+    }
+    return color;
+}
+
 /* \brief Charge Deposition for thread thread_num
  * \param pti         : Particle iterator
  * \param wp          : Array of particle weights
@@ -804,7 +897,7 @@ WarpXParticleContainer::PushX (int lev, Real dt)
 
     if (do_not_push) return;
 
-    MultiFab* cost = WarpX::getCosts(lev);
+    LayoutData<Real>* cost = WarpX::getCosts(lev);
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -847,15 +940,14 @@ WarpXParticleContainer::PushX (int lev, Real dt)
                 }
             );
 
-            if (cost) {
-                const Box& tbx = pti.tilebox();
-                wt = (amrex::second() - wt) / tbx.d_numPts();
-                Array4<Real> const& costarr = cost->array(pti);
-                amrex::ParallelFor(tbx,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-                {
-                    costarr(i,j,k) += wt;
-                });
+            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            {
+                Gpu::synchronize();
+                wt = amrex::second() - wt;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+                (*cost)[pti.index()] += wt;
             }
         }
     }
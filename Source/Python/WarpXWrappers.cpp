@@ -359,6 +359,14 @@ extern "C"
         return data;
     }
 
+    int warpx_getParticleCompIndex(int speciesnumber, const char* comp_name) {
+        auto & mypc = WarpX::GetInstance().GetPartContainer();
+        auto & myspc = mypc.GetParticleContainer(speciesnumber);
+
+        auto particle_comps = myspc.getParticleComps();
+        return particle_comps.at(comp_name);
+    }
+
     void warpx_ComputeDt () {
         WarpX& warpx = WarpX::GetInstance();
         warpx.ComputeDt ();
@@ -37,6 +37,12 @@ const std::map<std::string, int> gathering_algo_to_int = {
     {"default",    GatheringAlgo::Standard }
 };
 
+const std::map<std::string, int> load_balance_costs_update_algo_to_int = {
+    {"timers",    LoadBalanceCostsUpdateAlgo::Timers },
+    {"heuristic", LoadBalanceCostsUpdateAlgo::Heuristic },
+    {"default",   LoadBalanceCostsUpdateAlgo::Heuristic }
+};
+
 
 int
 GetAlgorithmInteger( amrex::ParmParse& pp, const char* pp_search_key ){
@@ -59,6 +65,8 @@ GetAlgorithmInteger( amrex::ParmParse& pp, const char* pp_search_key ){
         algo_to_int = charge_deposition_algo_to_int;
     } else if (0 == std::strcmp(pp_search_key, "field_gathering")) {
         algo_to_int = gathering_algo_to_int;
+    } else if (0 == std::strcmp(pp_search_key, "load_balance_costs_update")) {
+        algo_to_int = load_balance_costs_update_algo_to_int;
     } else {
         std::string pp_search_string = pp_search_key;
         amrex::Abort("Unknown algorithm type: " + pp_search_string);
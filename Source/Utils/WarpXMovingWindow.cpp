@@ -1,6 +1,9 @@
 #include <WarpX.H>
 #include <WarpXConst.H>
 
+#include <algorithm>
+#include <cstdlib>
+
 using namespace amrex;
 
 void
@@ -87,7 +90,12 @@ WarpX::MoveWindow (bool move_j)
     int num_shift      = num_shift_base;
     int num_shift_crse = num_shift;
 
-    // Shift the mesh fields
+    // Shift the mesh fields. On each level, the fields of the fine patch
+    // (and aux) and of the coarse patch are shifted together, so that
+    // their guard cells are exchanged at the same time.
+    auto add_mf = [] (Vector<MultiFab*>& mfs, MultiFab* mf) {
+        if (std::find(mfs.begin(), mfs.end(), mf) == mfs.end()) mfs.push_back(mf);
+    };
     for (int lev = 0; lev <= finest_level; ++lev) {
 
         if (lev > 0) {
@@ -95,36 +103,39 @@ WarpX::MoveWindow (bool move_j)
             num_shift *= refRatio(lev-1)[dir];
         }
 
+        Vector<MultiFab*> fine_mfs;
+        Vector<MultiFab*> crse_mfs;
+
         // Shift each component of vector fields (E, B, j)
         for (int dim = 0; dim < 3; ++dim) {
 
             // Fine grid
-            shiftMF(*Bfield_fp[lev][dim], geom[lev], num_shift, dir);
-            shiftMF(*Efield_fp[lev][dim], geom[lev], num_shift, dir);
+            add_mf(fine_mfs, Bfield_fp[lev][dim].get());
+            add_mf(fine_mfs, Efield_fp[lev][dim].get());
             if (move_j) {
-                shiftMF(*current_fp[lev][dim], geom[lev], num_shift, dir);
+                add_mf(fine_mfs, current_fp[lev][dim].get());
             }
             if (do_pml && pml[lev]->ok()) {
                 const std::array<MultiFab*, 3>& pml_B = pml[lev]->GetB_fp();
                 const std::array<MultiFab*, 3>& pml_E = pml[lev]->GetE_fp();
-                shiftMF(*pml_B[dim], geom[lev], num_shift, dir);
-                shiftMF(*pml_E[dim], geom[lev], num_shift, dir);
+                add_mf(fine_mfs, pml_B[dim]);
+                add_mf(fine_mfs, pml_E[dim]);
             }
 
             if (lev > 0) {
                 // Coarse grid
-                shiftMF(*Bfield_cp[lev][dim], geom[lev-1], num_shift_crse, dir);
-                shiftMF(*Efield_cp[lev][dim], geom[lev-1], num_shift_crse, dir);
-                shiftMF(*Bfield_aux[lev][dim], geom[lev], num_shift, dir);
-                shiftMF(*Efield_aux[lev][dim], geom[lev], num_shift, dir);
+                add_mf(crse_mfs, Bfield_cp[lev][dim].get());
+                add_mf(crse_mfs, Efield_cp[lev][dim].get());
+                add_mf(fine_mfs, Bfield_aux[lev][dim].get());
+                add_mf(fine_mfs, Efield_aux[lev][dim].get());
                 if (move_j) {
-                    shiftMF(*current_cp[lev][dim], geom[lev-1], num_shift_crse, dir);
+                    add_mf(crse_mfs, current_cp[lev][dim].get());
                 }
                 if (do_pml && pml[lev]->ok()) {
                     const std::array<MultiFab*, 3>& pml_B = pml[lev]->GetB_cp();
                     const std::array<MultiFab*, 3>& pml_E = pml[lev]->GetE_cp();
-                    shiftMF(*pml_B[dim], geom[lev-1], num_shift_crse, dir);
-                    shiftMF(*pml_E[dim], geom[lev-1], num_shift_crse, dir);
+                    add_mf(crse_mfs, pml_B[dim]);
+                    add_mf(crse_mfs, pml_E[dim]);
                 }
             }
         }
@@ -132,19 +143,17 @@ WarpX::MoveWindow (bool move_j)
         // Shift scalar component F for dive cleaning
         if (do_dive_cleaning) {
             // Fine grid
-            shiftMF(*F_fp[lev],   geom[lev], num_shift, dir);
+            add_mf(fine_mfs, F_fp[lev].get());
             if (do_pml && pml[lev]->ok()) {
-                MultiFab* pml_F = pml[lev]->GetF_fp();
-                shiftMF(*pml_F, geom[lev], num_shift, dir);
+                add_mf(fine_mfs, pml[lev]->GetF_fp());
             }
             if (lev > 0) {
                 // Coarse grid
-                shiftMF(*F_cp[lev], geom[lev-1], num_shift_crse, dir);
+                add_mf(crse_mfs, F_cp[lev].get());
                 if (do_pml && pml[lev]->ok()) {
-                    MultiFab* pml_F = pml[lev]->GetF_cp();
-                    shiftMF(*pml_F, geom[lev-1], num_shift_crse, dir);
+                    add_mf(crse_mfs, pml[lev]->GetF_cp());
                 }
-                shiftMF(*rho_cp[lev], geom[lev-1], num_shift_crse, dir);
+                add_mf(crse_mfs, rho_cp[lev].get());
             }
         }
 
@@ -152,13 +161,20 @@ WarpX::MoveWindow (bool move_j)
         if (move_j) {
             if (rho_fp[lev]){
                 // Fine grid
-                shiftMF(*rho_fp[lev],   geom[lev], num_shift, dir);
+                add_mf(fine_mfs, rho_fp[lev].get());
                 if (lev > 0){
                     // Coarse grid
-                    shiftMF(*rho_cp[lev], geom[lev-1], num_shift_crse, dir);
+                    add_mf(crse_mfs, rho_cp[lev].get());
                 }
             }
         }
+
+        if (lev > 0) {
+            shiftMFs(fine_mfs, geom[lev], num_shift,
+                     crse_mfs, geom[lev-1], num_shift_crse, dir);
+        } else {
+            shiftMFs(fine_mfs, geom[lev], num_shift, {}, geom[lev], 0, dir);
+        }
     }
 
     // Continuously inject plasma in new cells (by default only on level 0)
@@ -205,18 +221,36 @@ WarpX::MoveWindow (bool move_j)
 void
 WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir)
 {
-    BL_PROFILE("WarpX::shiftMF()");
+    shiftMFs({&mf}, geom, num_shift, {}, geom, 0, dir);
+}
+
+void
+WarpX::shiftMFs (const Vector<MultiFab*>& mfs, const Geometry& geom, int num_shift,
+                 const Vector<MultiFab*>& mfs2, const Geometry& geom2, int num_shift2,
+                 int dir)
+{
+    BL_PROFILE("WarpX::shiftMFs()");
+
+    // Exchange the guard cells of all the MultiFabs at once
+    for (MultiFab* mf : mfs) mf->FillBoundary_nowait(geom.periodicity());
+    for (MultiFab* mf : mfs2) mf->FillBoundary_nowait(geom2.periodicity());
+    for (MultiFab* mf : mfs) mf->FillBoundary_finish();
+    for (MultiFab* mf : mfs2) mf->FillBoundary_finish();
+
+    for (MultiFab* mf : mfs) shiftMFInPlace(*mf, geom, num_shift, dir);
+    for (MultiFab* mf : mfs2) shiftMFInPlace(*mf, geom2, num_shift2, dir);
+}
+
+void
+WarpX::shiftMFInPlace (MultiFab& mf, const Geometry& geom, int num_shift, int dir)
+{
+    BL_PROFILE("WarpX::shiftMFInPlace()");
     const BoxArray& ba = mf.boxArray();
-    const DistributionMapping& dm = mf.DistributionMap();
     const int nc = mf.nComp();
     const IntVect& ng = mf.nGrowVect();
 
     AMREX_ALWAYS_ASSERT(ng.min() >= num_shift);
 
-    MultiFab tmpmf(ba, dm, nc, ng);
-    MultiFab::Copy(tmpmf, mf, 0, 0, nc, ng);
-    tmpmf.FillBoundary(geom.periodicity());
-
     // Make a box that covers the region that the window moved into
     const IndexType& typ = ba.ixType();
     const Box& domainBox = geom.Domain();
@@ -244,20 +278,20 @@ WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir)
     IntVect shiftiv(0);
     shiftiv[dir] = num_shift;
     Dim3 shift = shiftiv.dim3();
+    const int abs_shift = std::abs(num_shift);
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-    for (MFIter mfi(tmpmf); mfi.isValid(); ++mfi )
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi )
     {
-        auto const& dstfab = mf.array(mfi);
-        auto const& srcfab = tmpmf.array(mfi);
+        auto const& fab = mf.array(mfi);
 
         const Box& outbox = mfi.fabbox() & adjBox;
         if (outbox.ok()) {
             AMREX_PARALLEL_FOR_4D ( outbox, nc, i, j, k, n,
             {
-                srcfab(i,j,k,n) = 0.0;
+                fab(i,j,k,n) = 0.0;
             });
         }
 
@@ -267,10 +301,28 @@ WarpX::shiftMF (MultiFab& mf, const Geometry& geom, int num_shift, int dir)
         } else {
             dstBox.growLo(dir,  num_shift);
         }
-        AMREX_PARALLEL_FOR_4D ( dstBox, nc, i, j, k, n,
+        if (!dstBox.ok() || num_shift == 0) continue;
+
+        // The data is shifted in place, by slabs of abs_shift cells along
+        // dir, starting from the side towards which the window moves:
+        // each slab only reads from the next slab, which was not modified yet.
+        const int lo = dstBox.smallEnd(dir);
+        const int hi = dstBox.bigEnd(dir);
+        for (int islab = 0; islab*abs_shift <= hi-lo; ++islab)
         {
-            dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
-        });
+            Box slab = dstBox;
+            if (num_shift > 0) {
+                slab.setSmall(dir, lo + islab*abs_shift);
+                slab.setBig(dir, std::min(hi, lo + (islab+1)*abs_shift - 1));
+            } else {
+                slab.setBig(dir, hi - islab*abs_shift);
+                slab.setSmall(dir, std::max(lo, hi - (islab+1)*abs_shift + 1));
+            }
+            AMREX_PARALLEL_FOR_4D ( slab, nc, i, j, k, n,
+            {
+                fab(i,j,k,n) = fab(i+shift.x,j+shift.y,k+shift.z,n);
+            });
+        }
     }
 }
 
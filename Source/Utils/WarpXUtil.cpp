@@ -152,3 +152,36 @@ void NullifyMF(amrex::MultiFab& mf, int lev, amrex::Real zmin, amrex::Real zmax)
         }
     }
 }
+
+void RemapMultiFab(MultiFab& mf, const MultiFab& src, const Periodicity& period)
+{
+    BL_PROFILE("RemapMultiFab()");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(src.nComp() == mf.nComp() &&
+                                     src.ixType() == mf.ixType(),
+        "RemapMultiFab: the data read does not match the field");
+    mf.ParallelCopy(src, 0, 0, mf.nComp(), IntVect::TheZeroVector(), mf.nGrowVect(), period);
+}
+
+void CostsToMultiFab(const LayoutData<Real>& costs, MultiFab& mf, int dcomp)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.validbox();
+        const Real wt = costs[mfi] / bx.d_numPts();
+        auto const& arr = mf.array(mfi);
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            arr(i,j,k,dcomp) = wt;
+        });
+    }
+}
+
+void MultiFabToCosts(const MultiFab& mf, LayoutData<Real>& costs)
+{
+    Gpu::synchronize();
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        costs[mfi] = mf[mfi].sum(mfi.validbox(), 0);
+    }
+}
@@ -41,6 +41,7 @@ long WarpX::charge_deposition_algo;
 long WarpX::field_gathering_algo;
 long WarpX::particle_pusher_algo;
 int WarpX::maxwell_fdtd_solver_id;
+long WarpX::load_balance_costs_update_algo;
 
 long WarpX::n_rz_azimuthal_modes = 1;
 long WarpX::ncomps = 1;
@@ -59,6 +60,7 @@ bool WarpX::refine_plasma     = false;
 int WarpX::num_mirrors = 0;
 
 int  WarpX::sort_int = -1;
+int  WarpX::sort_incremental = 0;
 
 bool WarpX::do_boosted_frame_diagnostic = false;
 std::string WarpX::lab_data_directory = "lab_frame_data";
@@ -185,6 +187,8 @@ WarpX::WarpX ()
 
     Efield_cax.resize(nlevs_max);
     Bfield_cax.resize(nlevs_max);
+    Efield_aux_diff.resize(nlevs_max);
+    Bfield_aux_diff.resize(nlevs_max);
     current_buffer_masks.resize(nlevs_max);
     gather_buffer_masks.resize(nlevs_max);
     current_buf.resize(nlevs_max);
@@ -386,9 +390,11 @@ WarpX::ReadParameters ()
         pp.query("serialize_ics", serialize_ics);
         pp.query("refine_plasma", refine_plasma);
         pp.query("do_dive_cleaning", do_dive_cleaning);
+        pp.query("overlap_field_comm", overlap_field_comm);
         pp.query("n_field_gather_buffer", n_field_gather_buffer);
         pp.query("n_current_deposition_buffer", n_current_deposition_buffer);
         pp.query("sort_int", sort_int);
+        pp.query("sort_incremental", sort_incremental);
 
         pp.query("do_pml", do_pml);
         pp.query("pml_ncell", pml_ncell);
@@ -487,6 +493,23 @@ WarpX::ReadParameters ()
             pp.query("particle_io_nfiles", particle_io_nfiles);
             ParmParse ppp("particles");
             ppp.add("particles_nfiles", particle_io_nfiles);
+
+            pp.query("async_output", async_output);
+            pp.query("async_output_max_mb", async_output_max_mb);
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(async_output_max_mb > 0,
+                "warpx.async_output_max_mb must be positive");
+
+            pp.query("checkpoint_full_int", checkpoint_full_int);
+            pp.query("checkpoint_delta_threshold", checkpoint_delta_threshold);
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(checkpoint_full_int >= 1,
+                "warpx.checkpoint_full_int must be at least 1");
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(checkpoint_delta_threshold >= 0.,
+                "warpx.checkpoint_delta_threshold must be non-negative");
+
+            pp.query("restart_remap", restart_remap);
+            pp.query("restart_max_grid_size", restart_max_grid_size);
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(restart_max_grid_size >= 0,
+                "warpx.restart_max_grid_size must be non-negative");
         }
 
         if (maxLevel() > 0) {
@@ -500,6 +523,11 @@ WarpX::ReadParameters ()
         pp.query("load_balance_int", load_balance_int);
         pp.query("load_balance_with_sfc", load_balance_with_sfc);
         pp.query("load_balance_knapsack_factor", load_balance_knapsack_factor);
+        pp.query("load_balance_adaptive", load_balance_adaptive);
+        pp.query("load_balance_threshold", load_balance_threshold);
+        pp.query("costs_heuristic_cells_wt", costs_heuristic_cells_wt);
+        pp.queryarr("costs_heuristic_particles_wt", costs_heuristic_particles_wt);
+        pp.query("costs_heuristic_calibration_steps", costs_heuristic_calibration_steps);
 
         pp.query("do_dynamic_scheduling", do_dynamic_scheduling);
 
@@ -539,6 +567,7 @@ WarpX::ReadParameters ()
         field_gathering_algo = GetAlgorithmInteger(pp, "field_gathering");
         particle_pusher_algo = GetAlgorithmInteger(pp, "particle_pusher");
         maxwell_fdtd_solver_id = GetAlgorithmInteger(pp, "maxwell_fdtd_solver");
+        load_balance_costs_update_algo = GetAlgorithmInteger(pp, "load_balance_costs_update");
     }
 
 #ifdef WARPX_USE_PSATD
@@ -634,6 +663,8 @@ WarpX::ClearLevel (int lev)
 
         Efield_cax[lev][i].reset();
         Bfield_cax[lev][i].reset();
+        Efield_aux_diff[lev][i].reset();
+        Bfield_aux_diff[lev][i].reset();
         current_buf[lev][i].reset();
     }
 
@@ -835,18 +866,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     }
     if (fft_hybrid_mpi_decomposition == false){
         // Allocate and initialize the spectral solver
-        std::array<Real,3> dx = CellSize(lev);
-#if (AMREX_SPACEDIM == 3)
-        RealVect dx_vect(dx[0], dx[1], dx[2]);
-#elif (AMREX_SPACEDIM == 2)
-        RealVect dx_vect(dx[0], dx[2]);
-#endif
-        // Get the cell-centered box, with guard cells
-        BoxArray realspace_ba = ba;  // Copy box
-        realspace_ba.enclosedCells().grow(ngE); // cell-centered + guard cells
-        // Define spectral solver
-        spectral_solver_fp[lev].reset( new SpectralSolver( realspace_ba, dm,
-            nox_fft, noy_fft, noz_fft, do_nodal, dx_vect, dt[lev] ) );
+        AllocLevelSpectralSolver(spectral_solver_fp, lev, ba, dm, ngE, CellSize(lev));
     }
 #endif
 
@@ -889,6 +909,12 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         Efield_cp[lev][1].reset( new MultiFab(amrex::convert(cba,Ey_nodal_flag),dm,ncomps,ngE));
         Efield_cp[lev][2].reset( new MultiFab(amrex::convert(cba,Ez_nodal_flag),dm,ncomps,ngE));
 
+        // Create the scratch MultiFabs used in UpdateAuxilaryData
+        for (int i = 0; i < 3; ++i) {
+            Bfield_aux_diff[lev][i].reset( new MultiFab(Bfield_cp[lev][i]->boxArray(),dm,ncomps,ngE));
+            Efield_aux_diff[lev][i].reset( new MultiFab(Efield_cp[lev][i]->boxArray(),dm,ncomps,ngE));
+        }
+
         // Create the MultiFabs for the current
         current_cp[lev][0].reset( new MultiFab(amrex::convert(cba,jx_nodal_flag),dm,ncomps,ngJ));
         current_cp[lev][1].reset( new MultiFab(amrex::convert(cba,jy_nodal_flag),dm,ncomps,ngJ));
@@ -908,18 +934,7 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         }
         if (fft_hybrid_mpi_decomposition == false){
             // Allocate and initialize the spectral solver
-            std::array<Real,3> cdx = CellSize(lev-1);
-    #if (AMREX_SPACEDIM == 3)
-            RealVect cdx_vect(cdx[0], cdx[1], cdx[2]);
-    #elif (AMREX_SPACEDIM == 2)
-            RealVect cdx_vect(cdx[0], cdx[2]);
-    #endif
-            // Get the cell-centered box, with guard cells
-            BoxArray realspace_ba = cba;  // Copy box
-            realspace_ba.enclosedCells().grow(ngE); // cell-centered + guard cells
-            // Define spectral solver
-            spectral_solver_cp[lev].reset( new SpectralSolver( realspace_ba, dm,
-                nox_fft, noy_fft, noz_fft, do_nodal, cdx_vect, dt[lev] ) );
+            AllocLevelSpectralSolver(spectral_solver_cp, lev, cba, dm, ngE, CellSize(lev-1));
         }
 #endif
     }
@@ -963,10 +978,35 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     }
 
     if (load_balance_int > 0) {
-        costs[lev].reset(new MultiFab(ba, dm, 1, 0));
+        costs[lev].reset(new LayoutData<Real>(ba, dm));
     }
 }
 
+#ifdef WARPX_USE_PSATD
+/* \brief Allocate the spectral solver of level `lev`, for the grids `ba`
+ * (cell-centered, without guard cells) with `ngE` guard cells and cell
+ * size `dx`. This is also used to rebuild the spectral solver after load
+ * balancing: the FFT plans of the boxes are then reused (see FFTPlanCache). */
+void
+WarpX::AllocLevelSpectralSolver (amrex::Vector<std::unique_ptr<SpectralSolver>>& spectral_solver,
+                                 const int lev, const BoxArray& ba,
+                                 const DistributionMapping& dm, const IntVect& ngE,
+                                 const std::array<Real,3>& dx)
+{
+#if (AMREX_SPACEDIM == 3)
+    RealVect dx_vect(dx[0], dx[1], dx[2]);
+#elif (AMREX_SPACEDIM == 2)
+    RealVect dx_vect(dx[0], dx[2]);
+#endif
+    // Get the cell-centered box, with guard cells
+    BoxArray realspace_ba = ba;  // Copy box
+    realspace_ba.enclosedCells().grow(ngE); // cell-centered + guard cells
+    // Define spectral solver
+    spectral_solver[lev].reset( new SpectralSolver( realspace_ba, dm,
+        nox_fft, noy_fft, noz_fft, do_nodal, dx_vect, dt[lev] ) );
+}
+#endif
+
 std::array<Real,3>
 WarpX::CellSize (int lev)
 {